@@ -36,6 +36,9 @@ class BuilderOptions : public spug::RCBase {
         bool debugMode;
         // Keep compile time statistics
         bool statsMode;
+        // Generate code that can be sampled by the profiler (keep frame 
+        // pointers)
+        bool profileMode;
         // builder specific option strings
         StringMap optionMap;
 
@@ -45,6 +48,7 @@ class BuilderOptions : public spug::RCBase {
                               dumpMode(false),
                               debugMode(false),
                               statsMode(false),
+                              profileMode(false),
                               optionMap() { }
 
 };
@@ -52,7 +52,7 @@ using namespace crack::util;
 #define VLOG(level) if (options->verbosity >= (level)) cerr
 
 // metadata version
-const std::string Cacher::MD_VERSION = "1";
+const std::string Cacher::MD_VERSION = "2";
 
 namespace {
     ConstantInt *constInt(int c) {
@@ -804,13 +804,20 @@ ResultExprPtr LLVMBuilder::emitAlloc(Context &context, AllocExpr *allocExpr,
         countVal = ConstantInt::get(llvmIntType, 1);
     }
 
-    // construct a call to the "calloc" function
-    BTypeDef *voidptrType =
-        BTypeDefPtr::arcast(context.construct->voidptrType);
-    vector<Value *> callocArgs(2);
-    callocArgs[0] = countVal;
-    callocArgs[1] = size;
-    Value *result = builder.CreateCall(callocFunc, callocArgs);
+    // single instances of Object classes come from the runtime's object
+    // allocator (which recycles their memory, Object.oper release() frees
+    // them with freeObject()), everything else from calloc.  The object type
+    // is set as soon as crack.lang defines it, see Parser::parseClassDef().
+    Value *result;
+    TypeDef *objectType = context.construct->objectType.get();
+    if (!countExpr && objectType && btype->isDerivedFrom(objectType)) {
+        result = builder.CreateCall(allocObjectFunc, size);
+    } else {
+        vector<Value *> callocArgs(2);
+        callocArgs[0] = countVal;
+        callocArgs[1] = size;
+        result = builder.CreateCall(callocFunc, callocArgs);
+    }
     lastValue = builder.CreateBitCast(result, tp);
 
     return new BResultExpr(allocExpr, lastValue);
@@ -3027,6 +3034,18 @@ void LLVMBuilder::createModuleCommon(Context &context) {
         callocFunc = f.funcDef->getRep(*this);
     }
 
+    // create "voidptr __CrackAllocObject(uint size)"
+    {
+        FuncBuilder f(context, FuncDef::noFlags, voidptrType,
+                      "__CrackAllocObject",
+                      1
+                      );
+        f.addArg("size", intType);
+        f.setSymbolName("__CrackAllocObject");
+        f.finish();
+        allocObjectFunc = f.funcDef->getRep(*this);
+    }
+
     // create "array[byteptr] __getArgv()"
     {
         TypeDefPtr array = context.ns->lookUp("array");
@@ -41,6 +41,7 @@ class LLVMBuilder : public Builder {
     protected:
 
         llvm::Function *callocFunc;
+        llvm::Function *allocObjectFunc;
         DebugInfo *debugInfo;
         BTypeDefPtr exStructType;
         
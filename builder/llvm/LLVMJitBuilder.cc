@@ -29,6 +29,8 @@
 #include <llvm/Assembly/PrintModulePass.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JIT.h>  // link in the JIT
+#include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/Analysis/DebugInfo.h>
 #include <llvm/Module.h>
 #include <llvm/IntrinsicInst.h>
 #include <llvm/Intrinsics.h>
@@ -40,6 +42,42 @@ using namespace model;
 using namespace builder;
 using namespace builder::mvll;
 
+namespace {
+
+    // Records the address range and line starts of every function the JIT 
+    // emits in the debug tables.  They're committed in bulk when the module 
+    // is finished.
+    class DebugTableListener : public JITEventListener {
+        public:
+            virtual void NotifyFunctionEmitted(
+                const Function &func,
+                void *code,
+                size_t size,
+                const EmittedFunctionDetails &details
+            ) {
+                crack::debug::registerDebugInfo(code, func.getName().str(), 
+                                                "",
+                                                0,
+                                                size
+                                                );
+                
+                const LLVMContext &context = func.getContext();
+                for (size_t i = 0; i < details.LineStarts.size(); ++i) {
+                    const EmittedFunctionDetails::LineStart &start =
+                        details.LineStarts[i];
+                    DIScope scope(start.Loc.getScope(context));
+                    crack::debug::registerLineInfo(
+                        reinterpret_cast<void *>(start.Address),
+                        scope.getFilename().str(),
+                        start.Loc.getLine()
+                    );
+                }
+            }
+    };
+
+    DebugTableListener debugTableListener;
+}
+
 ModuleDefPtr LLVMJitBuilder::registerPrimFuncs(model::Context &context) {
 
     ModuleDefPtr mod = LLVMBuilder::registerPrimFuncs(context);
@@ -92,6 +130,7 @@ void LLVMJitBuilder::engineFinishModule(Context &context,
     // XXX right now, only checking for > 0, later perhaps we can
     // run specific optimizations at different levels
     if (options->optimizeLevel) {
+        StatState sState(&context, ConstructStats::optimizer);
 
         // optimize
         llvm::PassManager passMan;
@@ -170,8 +209,15 @@ ExecutionEngine *LLVMJitBuilder::bindJitModule(Module *mod) {
             TargetMachine *tm = eb.selectTarget();
             tm->Options.JITEmitDebugInfo = true;
             tm->Options.JITExceptionHandling = true;
+            
+            // the profiler walks the frame pointer chain.
+            if (options->profileMode) {
+                tm->Options.NoFramePointerElim = true;
+                tm->Options.NoFramePointerElimNonLeaf = true;
+            }
 
             execEng = eb.create(tm);
+            execEng->RegisterJITEventListener(&debugTableListener);
 
         }
     }
@@ -275,6 +321,7 @@ ModuleDefPtr LLVMJitBuilder::createModule(Context &context,
 void LLVMJitBuilder::cacheModule(Context &context, ModuleDef *mod) {
 
     assert(BModuleDefPtr::cast(mod)->rep == module);
+    StatState sState(&context, ConstructStats::cacheSave);
 
     // encode main function location in bitcode metadata
     vector<Value *> dList;
@@ -350,21 +397,17 @@ void LLVMJitBuilder::innerCloseModule(Context &context, ModuleDef *moduleDef) {
     }
     externals.clear();
 
-    // build the debug tables
+    // make sure all of the functions have been emitted (the listener 
+    // registers their debug info as they are) and build the debug tables.
     Module::FunctionListType &funcList = module->getFunctionList();
     for (Module::FunctionListType::iterator funcIter = funcList.begin();
          funcIter != funcList.end();
          ++funcIter
          ) {
-        string name = funcIter->getName();
         if (!funcIter->isDeclaration())
-            crack::debug::registerDebugInfo(
-                execEng->getPointerToGlobal(funcIter),
-                name,
-                "",   // file name
-                0     // line number
-            );
+            execEng->getPointerToGlobal(funcIter);
     }
+    crack::debug::commitDebugInfo();
 
     doRunOrDump(context);
     if (context.construct->cacheMode)
@@ -94,6 +94,7 @@ void LLVMLinkerBuilder::finishBuild(Context &context) {
 
     // if optimizing, do module level unit at a time
     if (options->optimizeLevel) {
+        StatState sState(&context, ConstructStats::optimizer);
         for (ModuleListType::iterator i = moduleList->begin();
              i != moduleList->end();
              ++i) {
@@ -147,6 +148,7 @@ void LLVMLinkerBuilder::finishBuild(Context &context) {
 
     // possible LTO optimizations
     if (options->optimizeLevel) {
+        StatState sState(&context, ConstructStats::optimizer);
         if (options->verbosity > 2)
             std::cerr << "link time optimize final IR" << std::endl;
         optimizeLink(finalir, options->debugMode);
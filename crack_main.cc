@@ -21,6 +21,7 @@
 #include "builder/llvm/LLVMJitBuilder.h"
 #include "builder/llvm/LLVMLinkerBuilder.h"
 #include "debug/DebugTools.h"
+#include "debug/Profiler.h"
 #include "Crack.h"
 #include "config.h"
 
@@ -30,7 +31,10 @@ typedef enum {
     jitBuilder,
     nativeBuilder,
     doubleBuilder = 1001,
-    dumpFuncTable = 1002
+    dumpFuncTable = 1002,
+    profile = 1003,
+    profileFormat = 1004,
+    cacheBootstrap = 1005
 } builderType;
 
 struct option longopts[] = {
@@ -45,6 +49,7 @@ struct option longopts[] = {
     {"quiet", false, 0, 'q'},
     {"no-cache", false, 0, 'C'},
     {"no-bootstrap", false, 0, 'n'},
+    {"cache-bootstrap", false, 0, cacheBootstrap},
     {"no-default-paths", false, 0, 'G'},
     {"migration-warnings", false, 0, 'm'},
     {"lib", true, 0, 'l'},
@@ -52,6 +57,8 @@ struct option longopts[] = {
     {"stats", false, 0, 0},
     {"dump-func-table", false, 0, dumpFuncTable},
     {"trace", true, 0, 't'},
+    {"profile", true, 0, profile},
+    {"profile-format", true, 0, profileFormat},
     {0, 0, 0, 0}
 };
 
@@ -92,6 +99,10 @@ void usage(int retval) {
         << endl;
     cout << " -n         --no-bootstrap       Do not load bootstrapping modules"
             << endl;
+    cout << "            --cache-bootstrap    Cache the bootstrapping modules "
+            "even if module" << endl;
+    cout << "                                 caching is off (faster startup)."
+        << endl;
     cout << " -v         --verbose            Verbose output, use more than once"
             " for greater effect" << endl;
     cout << " -q         --quiet              No extra output, implies"
@@ -108,6 +119,14 @@ void usage(int retval) {
         << endl;
     cout << "                                   Serializer"
         << endl;
+    cout << "            --profile <file>     Sample the program with the "
+            "profiler and write" << endl;
+    cout << "                                 the profile to <file>." << endl;
+    cout << "            --profile-format <format>" << endl;
+    cout << "                                 Profile output format: folded "
+            "(the default," << endl;
+    cout << "                                 for flame graphs) or pprof."
+        << endl;
     exit(retval);
 }
 
@@ -138,6 +157,8 @@ int main(int argc, char **argv) {
     bool optionsError = false;
     bool useDoubleBuilder = false;    
     bool doDumpFuncTable = false;
+    const char *profileFile = 0;
+    crack::debug::ProfileFormat profFormat = crack::debug::profileFolded;
     while ((opt = getopt_long(argc, argv, "+B:b:dgO:nCGml:vqt:", longopts, 
                               &idx
                               )
@@ -243,6 +264,23 @@ int main(int argc, char **argv) {
             case dumpFuncTable:
                 doDumpFuncTable = true;
                 break;
+            case cacheBootstrap:
+                crack.bootstrapCacheMode = true;
+                break;
+            case profile:
+                profileFile = optarg;
+                crack.options->profileMode = true;
+                break;
+            case profileFormat:
+                if (!strcmp("folded", optarg)) {
+                    profFormat = crack::debug::profileFolded;
+                } else if (!strcmp("pprof", optarg)) {
+                    profFormat = crack::debug::profilePprof;
+                } else {
+                    cerr << "Unknown profile format: " << optarg << endl;
+                    exit(1);
+                }
+                break;
             case 't':
                 if (!strcmp("Serializer", optarg)) {
                     model::Serializer::trace = true;
@@ -273,6 +311,11 @@ int main(int argc, char **argv) {
     if (!libPath.empty())
         crack.addToSourceLibPath(libPath);
 
+    if (profileFile && !crack::debug::startProfiler()) {
+        cerr << "Unable to start the profiler." << endl;
+        exit(1);
+    }
+
     // are there any more arguments?
     if (optind == argc) {
         cerr << "You need to define a script or the '-' option to read "
@@ -310,6 +353,15 @@ int main(int argc, char **argv) {
     if (doDumpFuncTable)
         crack::debug::dumpFuncTable(cerr);
 
+    if (profileFile) {
+        crack::debug::stopProfiler();
+        ofstream out(profileFile);
+        if (out.good())
+            crack::debug::writeProfile(out, profFormat);
+        else
+            cerr << "Unable to write profile to " << profileFile << endl;
+    }
+
     return rc;
 
 }
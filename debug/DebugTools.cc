@@ -8,33 +8,75 @@
 #include "config.h"
 #include "DebugTools.h"
 
+#include <assert.h>
+#include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #ifdef HAVE_MALLOC_H
 #include <malloc.h>
 #endif
-#include <map>
 #include <set>
+#include <vector>
 
 using namespace std;
 
 namespace {
     
     struct DebugInfo {
+        void *address;
+        size_t size;
         const char *funcName;
         const char *filename;
         int lineNumber;
         
-        DebugInfo(const char *funcName, const char *filename, int lineNumber) :
+        // the function's entries in the line table.
+        unsigned firstLine, lineCount;
+        
+        DebugInfo(void *address, size_t size, const char *funcName, 
+                  const char *filename, 
+                  int lineNumber,
+                  unsigned firstLine
+                  ) :
+            address(address),
+            size(size),
             funcName(funcName),
             filename(filename),
+            lineNumber(lineNumber),
+            firstLine(firstLine),
+            lineCount(0) {
+        }
+        
+        bool operator <(const DebugInfo &other) const {
+            return address < other.address;
+        }
+    };
+    
+    struct LineInfo {
+        void *address;
+        const char *filename;
+        int lineNumber;
+        
+        LineInfo(void *address, const char *filename, int lineNumber) :
+            address(address),
+            filename(filename),
             lineNumber(lineNumber) {
         }
         
-        DebugInfo() : funcName(0), filename(0), lineNumber(0) {}
+        bool operator <(const LineInfo &other) const {
+            return address < other.address;
+        }
     };
     
+    // compares an entry against a raw address for the binary searches.
+    struct AddressLess {
+        template <typename T>
+        bool operator ()(void *address, const T &entry) const {
+            return address < entry.address;
+        }
+    };
+
     struct InternedString {
         const char *val;
     
@@ -45,25 +87,55 @@ namespace {
         }
     };
     
-    struct InternedStringSet : public set<InternedString> {
-        ~InternedStringSet() {
-            for (InternedStringSet::iterator iter = begin();
-                 iter != end();
-                 ++iter
-                 )
-                free(const_cast<char *>(iter->val));
-        }
+    // Interned strings are copied into large blocks rather than allocated 
+    // individually.  They live for the life of the process.
+    class StringArena {
+        private:
+            static const size_t blockSize = 65536;
+            vector<char *> blocks;
+            size_t used;
+
+        public:
+            StringArena() : used(blockSize) {}
+            
+            ~StringArena() {
+                for (size_t i = 0; i < blocks.size(); ++i)
+                    free(blocks[i]);
+            }
+            
+            const char *copy(const char *val) {
+                size_t size = strlen(val) + 1;
+                if (size > blockSize) {
+                    char *block = (char *)malloc(size);
+                    blocks.insert(blocks.begin(), block);
+                    return (const char *)memcpy(block, val, size);
+                } else if (used + size > blockSize) {
+                    blocks.push_back((char *)malloc(blockSize));
+                    used = 0;
+                }
+                char *result = blocks.back() + used;
+                used += size;
+                return (const char *)memcpy(result, val, size);
+            }
     };
 
-    typedef map<void *, DebugInfo> DebugTable;
-    DebugTable debugTable;
-    InternedStringSet internTable;
+    typedef vector<DebugInfo> DebugTable;
+    typedef vector<LineInfo> LineTable;
+    
+    // "debugTable" is sorted by address, "pending" holds registrations that 
+    // haven't been merged into it yet.
+    DebugTable debugTable, pending;
+    LineTable lineTable;
+    set<InternedString> internTable;
+    StringArena stringArena;
 
     const InternedString &lookUpString(const InternedString &key) {
-        InternedStringSet::iterator iter = internTable.find(key);
+        set<InternedString>::iterator iter = internTable.find(key);
         if (iter == internTable.end())
             iter = 
-                internTable.insert(InternedString(strdup(key.val))).first;
+                internTable.insert(
+                    InternedString(stringArena.copy(key.val))
+                ).first;
         return *iter;
     }
 
@@ -71,51 +143,142 @@ namespace {
         InternedString key(str.c_str());
         return lookUpString(key);
     }
+    
+    // Returns the function containing 'address', null if there is none.
+    const DebugInfo *findFunc(void *address) {
+        if (!pending.empty())
+            crack::debug::commitDebugInfo();
+        
+        DebugTable::const_iterator i =
+            upper_bound(debugTable.begin(), debugTable.end(), address,
+                        AddressLess()
+                        );
+        if (i == debugTable.begin())
+            return 0;
+        --i;
+        if (i->size && 
+            (char *)address >= (char *)i->address + i->size
+            )
+            return 0;
+        return &*i;
+    }
 }
 
 void crack::debug::registerDebugInfo(void *address, 
                                      const string &funcName,
                                      const string &fileName,
-                                     int lineNumber
+                                     int lineNumber,
+                                     size_t size
                                      ) {
     const InternedString &name = lookUpString(funcName);
     const InternedString &file = lookUpString(fileName);
-    debugTable[address] = DebugInfo(name.val, file.val, lineNumber);
+    pending.push_back(DebugInfo(address, size, name.val, file.val, 
+                                lineNumber,
+                                lineTable.size()
+                                )
+                      );
+}
+
+void crack::debug::registerLineInfo(void *address, 
+                                    const string &fileName,
+                                    int lineNumber
+                                    ) {
+    assert(!pending.empty() && 
+           "registerLineInfo() called without a function");
+    const InternedString &file = lookUpString(fileName);
+    lineTable.push_back(LineInfo(address, file.val, lineNumber));
+    ++pending.back().lineCount;
 }
 
 void crack::debug::registerFuncTable(const char **table) {
+    const InternedString &empty = lookUpString(InternedString(""));
     while (table[0]) {
         const InternedString &name = lookUpString(InternedString(table[1]));
-        debugTable[(void *)table[0]] = 
-            DebugInfo(name.val, "", 0);
+        pending.push_back(DebugInfo((void *)table[0], 0, name.val, empty.val, 
+                                    0,
+                                    lineTable.size()
+                                    )
+                          );
         table = table + 2;
     }
+    commitDebugInfo();
 }
 
 extern "C" void __CrackRegisterFuncTable(const char **table) {
     crack::debug::registerFuncTable(table);
 }
 
-void crack::debug::getLocation(void *address, const char *info[3]) {
-    DebugTable::iterator i = debugTable.lower_bound(address);
-    if (i == debugTable.end() || i->first != address)
-        --i;
+void crack::debug::commitDebugInfo() {
+    if (pending.empty())
+        return;
+    
+    // line info is registered in emission order, which isn't necessarily 
+    // address order.
+    for (DebugTable::iterator i = pending.begin(); i != pending.end(); ++i)
+        sort(lineTable.begin() + i->firstLine, 
+             lineTable.begin() + i->firstLine + i->lineCount
+             );
     
-    if (i == debugTable.end()) {
+    // Merge the new batch into the table.  Code is usually allocated at 
+    // increasing addresses, in which case this is just an append.
+    stable_sort(pending.begin(), pending.end());
+    size_t oldSize = debugTable.size(), start = oldSize ? oldSize - 1 : 0;
+    debugTable.insert(debugTable.end(), pending.begin(), pending.end());
+    pending.clear();
+    if (oldSize && 
+        debugTable[oldSize].address <= debugTable[oldSize - 1].address
+        ) {
+        inplace_merge(debugTable.begin(), debugTable.begin() + oldSize,
+                      debugTable.end()
+                      );
+        start = 0;
+    }
+
+    // if a function was registered more than once, the last registration 
+    // wins (the sorts are stable, so that's the last of a run).
+    DebugTable::iterator out = debugTable.begin() + start;
+    for (DebugTable::iterator in = out; in != debugTable.end(); ++in) {
+        if (in + 1 != debugTable.end() && in[1].address == in->address)
+            continue;
+        *out++ = *in;
+    }
+    debugTable.erase(out, debugTable.end());
+}
+
+void crack::debug::getLocation(void *address, const char *info[3]) {
+    const DebugInfo *func = findFunc(address);
+    if (!func) {
         info[0] = info[1] = "unknown";
         info[2] = 0;
-    } else {
-        info[0] = i->second.funcName;
-        info[1] = i->second.filename;
-        info[2] = reinterpret_cast<const char *>(i->second.lineNumber);
+        return;
     }
+    
+    info[0] = func->funcName;
+    info[1] = func->filename;
+    info[2] = reinterpret_cast<const char *>(func->lineNumber);
+    
+    // find the line within the function.
+    LineTable::const_iterator begin = lineTable.begin() + func->firstLine,
+        end = begin + func->lineCount,
+        line = upper_bound(begin, end, address, AddressLess());
+    if (line != begin) {
+        --line;
+        info[1] = line->filename;
+        info[2] = reinterpret_cast<const char *>(line->lineNumber);
+    }
+}
+
+void *crack::debug::getFuncStart(void *address) {
+    const DebugInfo *func = findFunc(address);
+    return func ? func->address : 0;
 }
 
 void crack::debug::dumpFuncTable(ostream &out) {
+    commitDebugInfo();
     for (DebugTable::iterator i = debugTable.begin(); i != debugTable.end();
          ++i
          )
-        out << hex << i->first << " " << i->second.funcName << endl;
+        out << hex << i->address << " " << i->funcName << endl;
 }
 
 void *__builtin_frame_address(unsigned int level);
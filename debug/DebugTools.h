@@ -8,19 +8,41 @@
 #ifndef _crack_debug_DebugTools_h_
 #define _crack_debug_DebugTools_h_
 
+#include <stddef.h>
 #include <string>
 
 namespace crack { namespace debug {
 
-/** Register the debug info for a function in the lookup tables. */
+/**
+ * Register the debug info for a function in the lookup tables.  'size' is 
+ * the size of the function's code, zero if it is unknown (in which case the 
+ * function is assumed to extend to the next registered function).
+ * Registrations are batched: they are merged into the lookup table in bulk 
+ * by commitDebugInfo() or by the next lookup.
+ */
 void registerDebugInfo(void *address, const std::string &funcName,
                        const std::string &fileName,
-                       int lineNumber
+                       int lineNumber,
+                       size_t size = 0
                        );
 
+/**
+ * Register the source line of the code starting at 'address', which must lie
+ * within the function most recently passed to registerDebugInfo().
+ */
+void registerLineInfo(void *address, const std::string &fileName,
+                      int lineNumber
+                      );
+
 /** Register an entire function table.  */
 void registerFuncTable(const char **table);
 
+/**
+ * Merge all pending registrations into the lookup table.  Builders call this 
+ * once a module has been jitted or linked.
+ */
+void commitDebugInfo();
+
 /**
  * Finds the source location for the specified address.
  * Source info is an array of three elements:
@@ -28,9 +50,19 @@ void registerFuncTable(const char **table);
  * - the source file name
  * - the line number (stored as an integer in the pointer).
  * All three values may be null if the source information can not be obtained.
+ * The lookup is a binary search of the function table followed by one of the 
+ * function's line table, and does not allocate unless there are pending 
+ * registrations to commit.
  */
 void getLocation(void *address, const char *info[3]);
 
+/**
+ * Returns the start address of the function containing 'address', null if 
+ * it is not in a registered function.  Profilers use this to aggregate 
+ * samples by function.
+ */
+void *getFuncStart(void *address);
+
 /**
  * Write the entire function table to the specified stream.
  */
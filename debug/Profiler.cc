@@ -0,0 +1,337 @@
+// Copyright 2012 Google Inc.
+//
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "Profiler.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include "DebugTools.h"
+
+using namespace std;
+
+namespace {
+
+    // the maximum number of frames recorded for a sample.
+    const unsigned maxDepth = 64;
+
+    // frame pointers further than this from the interrupted stack pointer
+    // are assumed to be garbage.
+    const long maxStackSize = 8 << 20;
+
+    // number of slots in the stack table (must be a power of two) and the
+    // number of addresses in the stack arena.
+    const unsigned tableSize = 1 << 16;
+    const unsigned arenaSize = 1 << 20;
+
+    // A distinct stack.  The addresses are stored in the arena starting at
+    // "offset", innermost first.
+    struct StackSlot {
+        unsigned hash;
+        unsigned depth;
+        unsigned offset;
+        unsigned long count;
+    };
+
+    // The tables are allocated when the profiler is started and are only
+    // written by the signal handler, which is serialized by "busy".
+    StackSlot *stackTable = 0;
+    void **arena = 0;
+    unsigned arenaUsed = 0, stacksUsed = 0;
+    volatile int busy = 0;
+    volatile unsigned long droppedSamples = 0;
+    int samplePeriod = 0;
+    bool running = false;
+    struct sigaction oldAction;
+
+    // Walks the frame pointer chain of the interrupted code, storing return
+    // addresses in 'pcs' starting with the interrupted instruction.  Returns
+    // the number of addresses stored.
+    unsigned walkStack(void *context, void **pcs) {
+        void **fp, *pc;
+        char *sp;
+
+#if defined(__linux__) && defined(__x86_64__)
+        mcontext_t &mc = reinterpret_cast<ucontext_t *>(context)->uc_mcontext;
+        pc = reinterpret_cast<void *>(mc.gregs[REG_RIP]);
+        fp = reinterpret_cast<void **>(mc.gregs[REG_RBP]);
+        sp = reinterpret_cast<char *>(mc.gregs[REG_RSP]);
+#elif defined(__linux__) && defined(__i386__)
+        mcontext_t &mc = reinterpret_cast<ucontext_t *>(context)->uc_mcontext;
+        pc = reinterpret_cast<void *>(mc.gregs[REG_EIP]);
+        fp = reinterpret_cast<void **>(mc.gregs[REG_EBP]);
+        sp = reinterpret_cast<char *>(mc.gregs[REG_ESP]);
+#else
+        // no access to the interrupted registers, start at the handler.
+        fp = reinterpret_cast<void **>(crack::debug::getStackFrame());
+        pc = 0;
+        sp = reinterpret_cast<char *>(fp);
+#endif
+
+        unsigned depth = 0;
+        if (pc)
+            pcs[depth++] = pc;
+
+        // frames that don't look like they belong to this stack end the
+        // walk: code compiled without frame pointers (and the prologues and
+        // epilogues of code compiled with them) leave arbitrary values in
+        // the frame pointer register.
+        while (depth < maxDepth && fp &&
+               !(reinterpret_cast<uintptr_t>(fp) & (sizeof(void *) - 1)) &&
+               reinterpret_cast<char *>(fp) >= sp &&
+               reinterpret_cast<char *>(fp) < sp + maxStackSize
+               ) {
+            void **next = reinterpret_cast<void **>(fp[0]);
+            if (!fp[1])
+                break;
+            pcs[depth++] = fp[1];
+            if (next <= fp ||
+                reinterpret_cast<char *>(next) -
+                 reinterpret_cast<char *>(fp) > (1 << 20)
+                )
+                break;
+            fp = next;
+        }
+
+        return depth;
+    }
+
+    unsigned hashStack(void **pcs, unsigned depth) {
+        uintptr_t hash = depth;
+        for (unsigned i = 0; i < depth; ++i)
+            hash = hash * 31 + reinterpret_cast<uintptr_t>(pcs[i]);
+        return static_cast<unsigned>(hash ^ (hash >> 29));
+    }
+
+    // Adds a sample to the stack table.  Only called from the signal
+    // handler, this can't allocate or lock.
+    void recordSample(void **pcs, unsigned depth) {
+        unsigned hash = hashStack(pcs, depth);
+        for (unsigned i = hash & (tableSize - 1), probes = 0;
+             probes < tableSize / 2;
+             i = (i + 1) & (tableSize - 1), ++probes
+             ) {
+            StackSlot &slot = stackTable[i];
+            if (!slot.count) {
+                // new stack
+                if (arenaUsed + depth > arenaSize)
+                    break;
+                memcpy(arena + arenaUsed, pcs, depth * sizeof(void *));
+                slot.hash = hash;
+                slot.depth = depth;
+                slot.offset = arenaUsed;
+                slot.count = 1;
+                arenaUsed += depth;
+                ++stacksUsed;
+                return;
+            } else if (slot.hash == hash && slot.depth == depth &&
+                       !memcmp(arena + slot.offset, pcs,
+                               depth * sizeof(void *)
+                               )
+                       ) {
+                ++slot.count;
+                return;
+            }
+        }
+
+        // out of room
+        ++droppedSamples;
+    }
+
+    void handleSigProf(int signal, siginfo_t *info, void *context) {
+        int savedErrno = errno;
+
+        // SIGPROF can be delivered to several threads at once, drop the
+        // sample rather than wait for another handler.
+        if (__sync_lock_test_and_set(&busy, 1)) {
+            __sync_fetch_and_add(&droppedSamples, 1);
+        } else {
+            void *pcs[maxDepth];
+            unsigned depth = walkStack(context, pcs);
+            if (depth && stackTable)
+                recordSample(pcs, depth);
+            __sync_lock_release(&busy);
+        }
+
+        errno = savedErrno;
+    }
+
+    void setTimer(int usecs) {
+        itimerval timer;
+        timer.it_interval.tv_sec = usecs / 1000000;
+        timer.it_interval.tv_usec = usecs % 1000000;
+        timer.it_value = timer.it_interval;
+        setitimer(ITIMER_PROF, &timer, 0);
+    }
+
+    // Returns the name of the function containing 'address', falling back
+    // to the dynamic symbol table for functions that aren't crack code.
+    string getFuncName(void *address) {
+        const char *info[3];
+        crack::debug::getLocation(address, info);
+        if (info[0] && strcmp(info[0], "unknown"))
+            return info[0];
+
+        Dl_info dlInfo;
+        if (dladdr(address, &dlInfo) && dlInfo.dli_sname)
+            return dlInfo.dli_sname;
+        return "[unknown]";
+    }
+
+    // Returns the address used to look up the function for the frame at
+    // 'index' of a stack: callers are recorded by their return address, which
+    // can be past the end of the function if the call was the last
+    // instruction.
+    void *lookUpAddress(void **pcs, int index) {
+        return index ? reinterpret_cast<char *>(pcs[index]) - 1 : pcs[index];
+    }
+
+    void writeWord(ostream &out, uintptr_t word) {
+        out.write(reinterpret_cast<const char *>(&word), sizeof(word));
+    }
+
+    void writeFolded(ostream &out) {
+
+        // stacks that differ only in their addresses within functions are
+        // the same stack once they're symbolized.
+        map<void *, string> names;
+        map<string, unsigned long> stacks;
+        for (unsigned i = 0; i < tableSize; ++i) {
+            StackSlot &slot = stackTable[i];
+            if (!slot.count)
+                continue;
+
+            string folded;
+            void **pcs = arena + slot.offset;
+            for (int j = slot.depth - 1; j >= 0; --j) {
+                void *addr = lookUpAddress(pcs, j);
+                map<void *, string>::iterator name = names.find(addr);
+                if (name == names.end())
+                    name = names.insert(make_pair(addr, getFuncName(addr))).first;
+                folded.append(name->second);
+                if (j)
+                    folded.push_back(';');
+            }
+            stacks[folded] += slot.count;
+        }
+
+        for (map<string, unsigned long>::iterator iter = stacks.begin();
+             iter != stacks.end();
+             ++iter
+             )
+            out << iter->first << ' ' << iter->second << '\n';
+    }
+
+    void writePprof(ostream &out) {
+
+        // the symbol table.  pprof adjusts caller addresses the same way we
+        // do before looking them up.
+        out << "--- symbol\nbinary=crack\n";
+        set<void *> addrs;
+        for (unsigned i = 0; i < tableSize; ++i) {
+            StackSlot &slot = stackTable[i];
+            for (unsigned j = 0; j < slot.depth && slot.count; ++j) {
+                void *addr = lookUpAddress(arena + slot.offset, j);
+                if (addrs.insert(addr).second)
+                    out << addr << ' ' << getFuncName(addr) << '\n';
+            }
+        }
+        out << "---\n--- profile\n";
+
+        // the binary profile: header, samples and trailer.
+        writeWord(out, 0);
+        writeWord(out, 3);
+        writeWord(out, 0);
+        writeWord(out, samplePeriod);
+        writeWord(out, 0);
+        for (unsigned i = 0; i < tableSize; ++i) {
+            StackSlot &slot = stackTable[i];
+            if (!slot.count)
+                continue;
+            writeWord(out, slot.count);
+            writeWord(out, slot.depth);
+            for (unsigned j = 0; j < slot.depth; ++j)
+                writeWord(out, reinterpret_cast<uintptr_t>(arena[slot.offset + j]));
+        }
+        writeWord(out, 0);
+        writeWord(out, 1);
+        writeWord(out, 0);
+
+        // pprof expects the process memory map after the samples.
+        ifstream maps("/proc/self/maps");
+        if (maps.good())
+            out << maps.rdbuf();
+    }
+}
+
+bool crack::debug::startProfiler(int frequency) {
+    if (running || frequency <= 0)
+        return false;
+
+    if (!stackTable) {
+        stackTable = new StackSlot[tableSize];
+        memset(stackTable, 0, tableSize * sizeof(StackSlot));
+        arena = new void *[arenaSize];
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = handleSigProf;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &oldAction))
+        return false;
+
+    samplePeriod = 1000000 / frequency;
+    if (!samplePeriod)
+        samplePeriod = 1;
+    setTimer(samplePeriod);
+    running = true;
+    return true;
+}
+
+void crack::debug::stopProfiler() {
+    if (!running)
+        return;
+
+    // stop the timer before restoring the handler so we don't get killed by
+    // a pending SIGPROF.
+    setTimer(0);
+    sigaction(SIGPROF, &oldAction, 0);
+    running = false;
+}
+
+void crack::debug::writeProfile(ostream &out, ProfileFormat format) {
+    if (!stackTable)
+        return;
+
+    // make sure the handler isn't writing while we read.
+    while (__sync_lock_test_and_set(&busy, 1))
+        ;
+
+    if (format == profileFolded)
+        writeFolded(out);
+    else
+        writePprof(out);
+
+    __sync_lock_release(&busy);
+
+    if (droppedSamples)
+        cerr << "profiler: dropped " << droppedSamples << " samples" << endl;
+}
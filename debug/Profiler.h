@@ -0,0 +1,48 @@
+// Copyright 2012 Google Inc.
+//
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+
+#ifndef _crack_debug_Profiler_h_
+#define _crack_debug_Profiler_h_
+
+#include <iostream>
+
+namespace crack { namespace debug {
+
+enum ProfileFormat {
+
+    // "folded stacks": one line per distinct stack with the frames
+    // separated by semicolons, outermost first, followed by the sample
+    // count (the input format of flamegraph.pl).
+    profileFolded,
+
+    // a pprof symbolized CPU profile (a symbol table followed by the legacy
+    // binary profile).
+    profilePprof
+};
+
+/**
+ * Start the sampling profiler.  The profiler takes 'frequency' samples per
+ * second of CPU time from SIGPROF, walking the frame pointer chain of the
+ * interrupted code.  Samples are aggregated in preallocated tables by the
+ * signal handler, they are only symbolized when the profile is written.
+ * Returns false if the profiler is already running or the signal handler or
+ * timer can not be installed.
+ */
+bool startProfiler(int frequency = 100);
+
+/** Stops the profiler.  Collected samples are retained. */
+void stopProfiler();
+
+/**
+ * Writes the collected samples to 'out', resolving addresses through the
+ * debug function table.
+ */
+void writeProfile(std::ostream &out, ProfileFormat format);
+
+}} // namespace crack::debug
+
+#endif
@@ -44,6 +44,26 @@ namespace {
             return lhs.second > rhs.second;
         }
     };
+
+    // turns on a construct's cacheMode for the lifetime of the instance if
+    // bootstrap caching was requested.
+    class BootstrapCacheMode {
+        private:
+            Construct *construct;
+            bool savedCacheMode;
+
+        public:
+            BootstrapCacheMode(Construct *construct) :
+                construct(construct),
+                savedCacheMode(construct->cacheMode) {
+                if (construct->bootstrapCacheMode)
+                    construct->cacheMode = true;
+            }
+
+            ~BootstrapCacheMode() {
+                construct->cacheMode = savedCacheMode;
+            }
+    };
 }
 
 void ConstructStats::showModuleCounts(std::ostream &out,
@@ -70,12 +90,31 @@ void ConstructStats::write(std::ostream &out) const {
     out << "\n------------------------------\n";
     out << "parsed     : " << parsedCount << "\n";
     out << "cached     : " << cachedCount << "\n";
+    out << "lines      : " << linesParsed << "\n";
     out << "------------------------------\n";
     printf("startup \t: %.10f\n", timing[start]);
     printf("builtin \t: %.10f\n", timing[builtin]);
     printf("parser  \t: %.10f\n", timing[parser]);
+    printf("toker   \t: %.10f\n", timing[toker]);
     printf("builder \t: %.10f\n", timing[builder]);
+    printf("optimizer\t: %.10f\n", timing[optimizer]);
+    printf("cacheLoad\t: %.10f\n", timing[cacheLoad]);
+    printf("cacheSave\t: %.10f\n", timing[cacheSave]);
     printf("executor\t: %.10f\n\n", timing[executor]);
+
+    // throughput of the compiler phases over the source lines that were
+    // parsed (cached modules don't count).
+    if (linesParsed) {
+        printf("toker lines/sec  \t: %.0f\n",
+               timing[toker] ? linesParsed / timing[toker] : 0.0
+               );
+        printf("parser lines/sec \t: %.0f\n",
+               timing[parser] ? linesParsed / timing[parser] : 0.0
+               );
+        printf("builder lines/sec\t: %.0f\n\n",
+               timing[builder] ? linesParsed / timing[builder] : 0.0
+               );
+    }
     showModuleCounts(out, "Parser Times (exclusive)", parseTimes);
     showModuleCounts(out, "Builder Times", buildTimes);
     showModuleCounts(out, "Executor Times", executeTimes);
@@ -101,6 +140,9 @@ void ConstructStats::stopwatch() {
             case executor:
                 executeTimes[curModule->getFullName()] += diff;
                 break;
+            default:
+                // the other phases are only reported as totals.
+                break;
         }
     } else {
         //printf("losing diff: %.10f, state: %d\n", diff, getState());
@@ -316,6 +358,11 @@ ContextPtr Construct::createRootContext() {
 }
 
 void Construct::loadBuiltinModules() {
+    // cached bootstrap modules refer to the builtins and crack.runtime, and
+    // the builder only registers their definitions for cache lookups in
+    // cacheMode, so turn it on here too if bootstrap caching is requested.
+    BootstrapCacheMode cacheModeGuard(this);
+
     // loads the compiler extension.  If we have a compile-time construct, 
     // the extension belongs to him and we just want to steal his defines.
     // Otherwise, we initialize them ourselves.
@@ -402,6 +449,8 @@ void Construct::parseModule(Context &context,
         stats->incParsed();
     }
     parser.parse();
+    if (sState.statsEnabled())
+        stats->addLines(toker.getLocation().getLineNumber());
     module->close(context);
     
     // if we're caching, store the module.
@@ -671,6 +720,16 @@ namespace {
 }
 
 bool Construct::loadBootstrapModules() {
+    
+    // turn on caching while we load the bootstrap modules if requested.
+    // The module loaders and the builders check the cacheMode flag as each 
+    // module is loaded or closed, so this covers crack.lang and everything 
+    // it imports.
+    BootstrapCacheMode cacheModeGuard(this);
+    return loadBootstrapModulesImpl();
+}
+
+bool Construct::loadBootstrapModulesImpl() {
     try {
         StringVec crackLangName(2);
         crackLangName[0] = "crack";
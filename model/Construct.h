@@ -37,12 +37,18 @@ SPUG_RCPTR(ConstructStats);
 class ConstructStats : public spug::RCBase {
 
 public:
-    enum CompileState { start=0, builtin, parser, builder, executor, end };
+    // 'toker' is the time spent tokenizing (excluded from 'parser'),
+    // 'optimizer' the time spent in LLVM optimization passes (excluded from
+    // 'builder').
+    enum CompileState { start=0, builtin, parser, toker, builder, optimizer,
+                        cacheLoad, cacheSave, executor, end
+                      };
     typedef std::map<std::string, double> ModuleTiming;
 
 protected:
     unsigned int parsedCount;
     unsigned int cachedCount;
+    unsigned int linesParsed;
     double timing[end+1];
     ModuleTiming parseTimes;
     ModuleTiming buildTimes;
@@ -62,7 +68,8 @@ public:
     ConstructStats(void):
         curState(start),
         parsedCount(0),
-        cachedCount(0) {
+        cachedCount(0),
+        linesParsed(0) {
         gettimeofday(&lastTime, NULL);
         for (int i = start; i <= end; i++)
             timing[i] = 0.0;
@@ -76,6 +83,18 @@ public:
 
     void incParsed() { parsedCount++; }
     void incCached() { cachedCount++; }
+    void addLines(unsigned int lines) { linesParsed += lines; }
+
+    /**
+     * Moves 'secs' of the time spent in the current state to 'state'.  This
+     * lets the parser split out the tokenizer without a state change (and
+     * its clock reads and module lookups) for every token.  Per-module
+     * parser times still include the moved time.
+     */
+    void chargeTime(CompileState state, double secs) {
+        timing[curState] -= secs;
+        timing[state] += secs;
+    }
 
     void write(std::ostream &out) const;
 
@@ -153,6 +172,9 @@ class Construct : public spug::RCBase, public Options {
         // Use of the registry is optional.  It currently facilitates caching.
         VarDefMap registry;
 
+        // loads the bootstrapping modules with the current cache settings.
+        bool loadBootstrapModulesImpl();
+
     public: // XXX should be private
         // if non-null, this is the alternate construct used for annotations.  
         // If it is null, either this _is_ the annotation construct or both 
@@ -355,7 +377,9 @@ class Construct : public spug::RCBase, public Options {
                                );
 
         /**
-         * Load the executor's bootstrapping modules (crack.lang).
+         * Load the executor's bootstrapping modules (crack.lang).  If 
+         * bootstrapCacheMode is set, they are loaded from (and stored to) the 
+         * persistent module cache.
          */
         bool loadBootstrapModules();
 
@@ -272,6 +272,8 @@ ModuleDefPtr Context::createModule(const string &name,
 
 ModuleDefPtr Context::materializeModule(const string &canonicalName,
                                         ModuleDef *owner) {
+    StatState sState(this, ConstructStats::cacheLoad);
+
     // check the cache path for module metadata.
     string metaDataPath = getCacheFilePath(builder.options.get(),
                                            *construct,
@@ -300,6 +302,7 @@ ModuleDefPtr Context::materializeModule(const string &canonicalName,
 }
 
 void Context::cacheModule(ModuleDef *mod) {
+    StatState sState(this, ConstructStats::cacheSave);
     string metaDataPath = getCacheFilePath(builder.options.get(),
                                            *construct,
                                            mod->getNamespaceName(),
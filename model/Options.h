@@ -20,7 +20,17 @@ struct Options {
     // date.
     bool cacheMode;
 
-    Options() : migrationWarnings(false), cacheMode(false) {}
+    // if true, cache the bootstrap modules (crack.lang and the modules it
+    // imports) even if cacheMode is false.  Cached modules are checked
+    // against the digests of their sources, so this is safe to leave on for
+    // scripts that are run frequently.
+    bool bootstrapCacheMode;
+
+    Options() :
+        migrationWarnings(false),
+        cacheMode(false),
+        bootstrapCacheMode(false) {
+    }
 
     // copy the options from another Options object.  This is useful because
     // we typically inherit this struct.
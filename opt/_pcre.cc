@@ -1,4 +1,14 @@
 #include <pcre.h>
+#ifndef PCRE_STUDY_JIT_COMPILE
+#define PCRE_STUDY_JIT_COMPILE 0
+#endif
+void crk_pcre_free_study(pcre_extra *extra) {
+#ifdef PCRE_CONFIG_JIT
+    pcre_free_study(extra);
+#else
+    pcre_free(extra);
+#endif
+}
 
 
 #include "ext/Module.h"
@@ -88,6 +98,18 @@ void crack_ext__pcre_cinit(crack::ext::Module *mod) {
        f->addArg(type_PCRE, "pcre");
        f->addArg(type_byteptr, "name");
 
+    f = mod->addFunc(type_voidptr, "pcre_study",
+                     (void *)pcre_study
+                     );
+       f->addArg(type_PCRE, "pcre");
+       f->addArg(type_int, "options");
+       f->addArg(array_pbyteptr_q, "errorText");
+
+    f = mod->addFunc(type_void, "pcre_free_study",
+                     (void *)crk_pcre_free_study
+                     );
+       f->addArg(type_voidptr, "extra");
+
 
     mod->addConstant(type_int, "PCRE_ANCHORED",
                      static_cast<int>(PCRE_ANCHORED)
@@ -144,4 +166,12 @@ void crack_ext__pcre_cinit(crack::ext::Module *mod) {
     mod->addConstant(type_int, "PCRE_NO_UTF8_CHECK",
                      static_cast<int>(PCRE_NO_UTF8_CHECK)
                      );
+
+    mod->addConstant(type_int, "PCRE_NOTEMPTY_ATSTART",
+                     static_cast<int>(PCRE_NOTEMPTY_ATSTART)
+                     );
+
+    mod->addConstant(type_int, "PCRE_STUDY_JIT_COMPILE",
+                     static_cast<int>(PCRE_STUDY_JIT_COMPILE)
+                     );
 }
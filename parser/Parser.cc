@@ -87,8 +87,23 @@ void Parser::addFuncDef(FuncDef *funcDef) {
    addDef(funcDef);
 }
 
-Token Parser::getToken() {
+Token Parser::readToken() {
+   if (!statsMode)
+      return toker.getToken();
+
+   timeval start, end;
+   gettimeofday(&start, NULL);
    Token tok = toker.getToken();
+   gettimeofday(&end, NULL);
+   context->construct->stats->chargeTime(
+      ConstructStats::toker,
+      (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0
+   );
+   return tok;
+}
+
+Token Parser::getToken() {
+   Token tok = readToken();
    context->setLocation(tok.getLocation());
    
    // short-circuit the parser for an annotation, which can occur anywhere.
@@ -97,7 +112,7 @@ Token Parser::getToken() {
          parseAnnotation();
       else
          context->popErrorContext();
-      tok = toker.getToken();
+      tok = readToken();
       context->setLocation(tok.getLocation());
    }
 
@@ -301,7 +316,7 @@ void Parser::parseAnnotation() {
       ContextStackFrame<Parser> cstack(*this, ctx.get());
       context->construct = context->getCompileTimeConstruct();
    
-      Token tok = toker.getToken();
+      Token tok = readToken();
       context->setLocation(tok.getLocation());
    
       // if we get an import keyword, parse the import statement.   
@@ -448,7 +463,7 @@ ContextPtr Parser::parseBlock(bool nested, Parser::Event closeEvent) {
          if (callbacks[closeEvent].size()) {
             toker.putBack(tok);
             runCallbacks(closeEvent);
-            Token tempTok = toker.getToken();
+            Token tempTok = readToken();
             if (!tempTok.isRCurly()) {
                // if the token is not what it was before, one of the callbacks 
                // has changed the token stream and we need to go back to the 
@@ -877,6 +892,29 @@ ExprPtr Parser::parsePostIdent(Expr *container, const Token &ident) {
 
 }
 
+FuncCallPtr Parser::createFormatCall(Expr *formatter, Expr *arg,
+                                     const Token &tok
+                                     ) {
+   // look up a format method for the argument
+   FuncCall::ExprVec args(1);
+   args[0] = arg;
+   FuncDefPtr func = context->lookUp("format", args, formatter->type.get());
+   if (!func)
+      error(tok, 
+            SPUG_FSTR("No format method exists for objects of type " <<
+                      arg->type->getDisplayName()
+                      )
+            );
+   
+   BSTATS_GO(s1)
+   FuncCallPtr funcCall = context->builder.createFuncCall(func.get());
+   BSTATS_END
+   funcCall->args = args;
+   if (func->flags & FuncDef::method)
+      funcCall->receiver = formatter;
+   return funcCall;
+}
+
 // ` ... `
 //  ^     ^
 ExprPtr Parser::parseIString(Expr *expr) {
@@ -900,13 +938,17 @@ ExprPtr Parser::parseIString(Expr *expr) {
       seq->add(funcCall.get());
    }
 
-   // parse all of the subtokens
-   Token tok;
+   // parse all of the subtokens.  Adjacent constant fragments are 
+   // coalesced so they get formatted with a single call.
+   Token tok, constTok;
+   string constText;
    while (!(tok = getToken()).isIstrEnd()) {
       ExprPtr arg;
       if (tok.isString()) {
           if (tok.getData().size() == 0) continue;
-          arg = context->getStrConst(tok.getData());
+          if (constText.empty()) constTok = tok;
+          constText += tok.getData();
+          continue;
       } else if (tok.isIdent()) {
          // get a variable definition
          arg = createVarRef(0, tok);
@@ -924,24 +966,19 @@ ExprPtr Parser::parseIString(Expr *expr) {
                     );
       }
 
-      // look up a format method for the argument
-      FuncCall::ExprVec args(1);
-      args[0] = arg;
-      func = context->lookUp("format", args, expr->type.get());
-      if (!func)
-         error(tok, 
-               SPUG_FSTR("No format method exists for objects of type " <<
-                         arg->type->getDisplayName()
-                         )
-               );
-      
-      BSTATS_GO(s1)
-      FuncCallPtr funcCall = context->builder.createFuncCall(func.get());
-      BSTATS_END
-      funcCall->args = args;
-      if (func->flags & FuncDef::method)
-         funcCall->receiver = reg;
-      seq->add(funcCall.get());
+      // flush any pending constant text before the argument
+      if (!constText.empty()) {
+         ExprPtr text = context->getStrConst(constText);
+         seq->add(createFormatCall(reg.get(), text.get(), constTok).get());
+         constText.clear();
+      }
+
+      seq->add(createFormatCall(reg.get(), arg.get(), tok).get());
+   }
+
+   if (!constText.empty()) {
+      ExprPtr text = context->getStrConst(constText);
+      seq->add(createFormatCall(reg.get(), text.get(), constTok).get());
    }
 
    func = context->lookUpNoArgs("leave", true, expr->type.get());
@@ -1220,7 +1257,7 @@ ExprPtr Parser::parseSecondary(Expr *expr0, unsigned precedence) {
                   );
          
          // check for a square bracket
-         tok = toker.getToken();
+         tok = readToken();
          if (!tok.isLBracket())
             error(tok,
                   "Sequence initializer ('[ ... ]') expected after "
@@ -2810,7 +2847,7 @@ void Parser::parseImportStmt(Namespace *ns) {
 // try { ... } catch (...) { ... }
 //    ^                           ^
 ContextPtr Parser::parseTryStmt() {
-   Token tok = toker.getToken();
+   Token tok = readToken();
    if (!tok.isLCurly())
       unexpected(tok, "Curly bracket expected after try.");
    
@@ -2834,14 +2871,14 @@ ContextPtr Parser::parseTryStmt() {
    // finally/catch clauses are thrown to outer contexts. 
    context->setCatchBranchpoint(0);
    
-   tok = toker.getToken();
+   tok = readToken();
    if (!tok.isCatch())
       unexpected(tok, "catch expected after try block.");
    
    while (true) {
       
       // parse the exception specifier
-      tok = toker.getToken();
+      tok = readToken();
       if (!tok.isLParen())
          unexpected(tok, 
                     "parenthesized catch expression expected after catch "
@@ -2851,7 +2888,7 @@ ContextPtr Parser::parseTryStmt() {
       TypeDefPtr exceptionType = parseTypeSpec();
       
       // parse the exception variable
-      Token varTok = toker.getToken();
+      Token varTok = readToken();
       if (!varTok.isIdent())
          unexpected(tok, "variable name expected after exception type.");
 
@@ -2862,14 +2899,14 @@ ContextPtr Parser::parseTryStmt() {
                                     );
       BSTATS_END
 
-      tok = toker.getToken();
+      tok = readToken();
       if (!tok.isRParen())
          unexpected(tok, 
                     "closing parenthesis expected after exception variable."
                     );
       
       // parse the catch body
-      tok = toker.getToken();
+      tok = readToken();
       if (!tok.isLCurly())
          unexpected(tok,
                     "Curly bracket expected after catch clause."
@@ -2903,7 +2940,7 @@ ContextPtr Parser::parseTryStmt() {
       }
       
       // see if there's another catch
-      tok = toker.getToken();
+      tok = readToken();
       if (!tok.isCatch()) {
          toker.putBack(tok);
          BSTATS_GO(s1)
@@ -2915,7 +2952,7 @@ ContextPtr Parser::parseTryStmt() {
 }
 
 ContextPtr Parser::parseThrowStmt() {
-   Token tok = toker.getToken();
+   Token tok = readToken();
    if (tok.isSemi()) {
       // XXX need to get this working and to verify that we are in a catch
       error(tok, "Rethrowing exceptions not supported yet.");
@@ -2931,7 +2968,7 @@ ContextPtr Parser::parseThrowStmt() {
                               )
                );
       
-      tok = toker.getToken();
+      tok = readToken();
       if (!tok.isSemi())
          unexpected(tok, "Semicolon expected after throw expression.");
 
@@ -3164,7 +3201,7 @@ void Parser::recordIStr(Generic *generic) {
 
    while (true) {
 
-      Token tok = toker.getToken();
+      Token tok = readToken();
       generic->addToken(tok);
       if (tok.isLParen())
          ++depth;
@@ -3182,7 +3219,7 @@ void Parser::recordBlock(Generic *generic) {
    while (bracketCount) {
       // get the next token, use the low-level token so as not to process 
       // annotations.
-      Token tok = toker.getToken();
+      Token tok = readToken();
       generic->addToken(tok);
       if (tok.isLCurly())
          ++bracketCount;
@@ -3322,6 +3359,15 @@ TypeDefPtr Parser::parseClassDef() {
    if (!existing)
       addDef(type.get());
 
+   // while bootstrapping, crack.lang's Object class becomes the object type 
+   // as soon as it is defined rather than after the module is loaded: the 
+   // builder allocates the instances of classes derived from it (including 
+   // the ones in crack.lang) with the object allocator.
+   if (!context->construct->objectType && className == "Object" &&
+       moduleCtx->ns->getNamespaceName() == "crack.lang"
+       )
+      context->construct->objectType = type;
+
    type->aliasBaseMetaTypes();
 
    // check for an abstract class
@@ -3360,7 +3406,8 @@ Parser::Parser(Toker &toker, model::Context *context) :
    toker(toker),
    nestID(0),
    moduleCtx(context),
-   context(context) {
+   context(context),
+   statsMode(context->construct->rootBuilder->options->statsMode) {
    
    // build the precedence table
    enum {  noPrec, logOrPrec, logAndPrec, bitOrPrec, bitXorPrec, bitAndPrec, 
@@ -3424,13 +3471,13 @@ void Parser::parseClassBody() {
          // still got an end curly
          toker.putBack(tok);
          if (runCallbacks(classLeave)) {
-            Token tok2 = toker.getToken();
+            Token tok2 = readToken();
             if (!tok2.isRCurly()) {
                toker.putBack(tok2);
                continue;
             }
          } else {
-            toker.getToken();
+            readToken();
          }
          break;
       } else if (tok.isSemi()) {
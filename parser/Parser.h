@@ -86,6 +86,10 @@ class Parser {
       // sequential identifier used in nested block namespaces
       int nestID;
 
+      // true if we're gathering compile statistics (checked once, because
+      // readToken() is called for every token).
+      bool statsMode;
+
       /**
        * This class essentially lets us manage the context stack with the
        * program's stack.  We push the context by creating an instance, and
@@ -108,6 +112,12 @@ class Parser {
 
       void addFuncDef(model::FuncDef *funcDef);
 
+      /**
+       * Returns the next token from the tokenizer, accounting the time spent
+       * in the tokenizer separately when gathering statistics.
+       */
+      Token readToken();
+
       /**
        * Returns the next token from the tokenizer and stores its location in
        * the current context.
@@ -226,6 +236,19 @@ class Parser {
        */
       model::ExprPtr parseIString(model::Expr *expr);
 
+      /**
+       * Create a call to the formatter's format() method for one fragment
+       * of an interpolated string.
+       *
+       * @param formatter the formatter register.
+       * @param arg the fragment to be formatted.
+       * @param tok the token to report errors against.
+       */
+      model::FuncCallPtr createFormatCall(model::Expr *formatter,
+                                          model::Expr *arg,
+                                          const Token &tok
+                                          );
+
       /**
        * Parse a sequence constant.
        *
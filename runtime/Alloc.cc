@@ -0,0 +1,137 @@
+// Copyright 2012 Google Inc.
+// 
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// 
+// Allocation of reference counted objects.
+
+#include "Alloc.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace crack { namespace runtime {
+
+// Every block starts with a header, the object follows it.  The header is 16 
+// bytes so objects keep the alignment of the C library allocator.
+struct BlockHeader {
+    // the size class of the block, 'numClasses' for large blocks.
+    unsigned int sizeClass;
+
+    // always 'blockMagic', lets us catch memory from other allocators.
+    unsigned int magic;
+
+    // the next block in the free list while the block is free.
+    BlockHeader *next;
+};
+
+// objects are allocated in multiples of 'granularity' bytes, the size classes
+// cover objects of up to granularity * numClasses bytes.  Each free list
+// holds at most 'maxFree' blocks, anything beyond that goes back to the C
+// library.
+static const size_t granularity = 16, numClasses = 16, maxFree = 64;
+static const unsigned int blockMagic = 0x0b1ec7a1;
+
+struct FreeLists {
+    BlockHeader *head[numClasses];
+    unsigned int count[numClasses];
+};
+
+// "threadFreeLists" is the fast path to the free lists of the current thread,
+// the pthread key exists so that we can release them when the thread
+// terminates.
+static __thread FreeLists *threadFreeLists = 0;
+static pthread_key_t freeListsKey;
+static pthread_once_t freeListsKeyOnce = PTHREAD_ONCE_INIT;
+
+static void deleteFreeLists(void *arg) {
+    FreeLists *lists = static_cast<FreeLists *>(arg);
+    for (size_t i = 0; i < numClasses; ++i) {
+        BlockHeader *block = lists->head[i];
+        while (block) {
+            BlockHeader *next = block->next;
+            free(block);
+            block = next;
+        }
+    }
+    free(lists);
+
+    // objects released by later thread destructors create a new set of lists
+    // (and the key destructor runs again for those).
+    threadFreeLists = 0;
+}
+
+static void initFreeListsKey() {
+    int rc = pthread_key_create(&freeListsKey, deleteFreeLists);
+    assert(rc == 0 && "Unable to create pthread key for object free lists.");
+}
+
+static FreeLists *getFreeLists() {
+    if (!threadFreeLists) {
+        pthread_once(&freeListsKeyOnce, initFreeListsKey);
+        threadFreeLists =
+            static_cast<FreeLists *>(calloc(1, sizeof(FreeLists)));
+        if (threadFreeLists)
+            pthread_setspecific(freeListsKey, threadFreeLists);
+    }
+    return threadFreeLists;
+}
+
+}} // namespace crack::runtime
+
+using namespace crack::runtime;
+
+extern "C" void *__CrackAllocObject(unsigned int size) {
+    size_t sizeClass = size ? (size - 1) / granularity : 0;
+    if (sizeClass < numClasses) {
+        size_t blockSize = (sizeClass + 1) * granularity;
+        FreeLists *lists = getFreeLists();
+        BlockHeader *block = lists ? lists->head[sizeClass] : 0;
+        if (block) {
+            lists->head[sizeClass] = block->next;
+            --lists->count[sizeClass];
+            memset(block + 1, 0, blockSize);
+        } else {
+            block = static_cast<BlockHeader *>(
+                calloc(1, sizeof(BlockHeader) + blockSize)
+            );
+            if (!block)
+                return 0;
+            block->sizeClass = sizeClass;
+            block->magic = blockMagic;
+        }
+        return block + 1;
+    }
+
+    BlockHeader *block =
+        static_cast<BlockHeader *>(calloc(1, sizeof(BlockHeader) + size));
+    if (!block)
+        return 0;
+    block->sizeClass = numClasses;
+    block->magic = blockMagic;
+    return block + 1;
+}
+
+extern "C" void __CrackFreeObject(void *obj) {
+    if (!obj)
+        return;
+
+    BlockHeader *block = static_cast<BlockHeader *>(obj) - 1;
+    assert(block->magic == blockMagic &&
+           "Object memory wasn't allocated by __CrackAllocObject()"
+           );
+    size_t sizeClass = block->sizeClass;
+    if (sizeClass < numClasses) {
+        FreeLists *lists = getFreeLists();
+        if (lists && lists->count[sizeClass] < maxFree) {
+            block->next = lists->head[sizeClass];
+            lists->head[sizeClass] = block;
+            ++lists->count[sizeClass];
+            return;
+        }
+    }
+    free(block);
+}
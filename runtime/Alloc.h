@@ -0,0 +1,32 @@
+// Copyright 2012 Google Inc.
+// 
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// 
+// Allocation of reference counted objects.
+
+#ifndef _runtime_Alloc_h_
+#define _runtime_Alloc_h_
+
+/**
+ * Allocates zeroed memory for an instance of a class derived from Object.
+ * This is what "oper new" uses for these classes.  Small instances are
+ * recycled through per-thread free lists, so short-lived objects (iterators,
+ * formatters, temporaries) don't go back to the C library allocator every
+ * time.  The memory must be released with __CrackFreeObject(), which may be
+ * called from any thread.
+ *
+ * Object.oper release() frees instances with __CrackFreeObject(), so memory
+ * for an Object instance that isn't created by the generated "oper new" (a
+ * custom "oper new" in an extension, for example) must also come from here.
+ */
+extern "C" void *__CrackAllocObject(unsigned int size);
+
+/**
+ * Releases memory allocated by __CrackAllocObject().  'obj' may be null.
+ * Passing memory from any other allocator is a fatal error in debug builds.
+ */
+extern "C" void __CrackFreeObject(void *obj);
+
+#endif
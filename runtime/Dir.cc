@@ -9,11 +9,21 @@
 // 
 
 #include <iostream>
+#include <deque>
+#include <string>
+#include <vector>
 
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include <fnmatch.h>
 #include <string.h>
 #include <libgen.h>
@@ -89,4 +99,357 @@ void *Dir_toVoidptr(Dir *dir) {
     return dir;
 }
 
+namespace {
+
+#ifdef __linux__
+    // the record returned by getdents64 (glibc doesn't define this)
+    struct LinuxDirent64 {
+        ino64_t d_ino;
+        off64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+    };
+#endif
+
+    bool isSpecial(const char *name) {
+        return name[0] == '.' &&
+               (!name[1] || (name[1] == '.' && !name[2]));
+    }
+
+    // Returns the crack type of the entry 'name' in the directory 'dirfd',
+    // 'type' is the type from the directory entry.  Only calls lstat if the
+    // filesystem didn't give us the type.
+    int getEntryType(int dirfd, const char *name, unsigned char type) {
+        if (type == DT_UNKNOWN) {
+            struct stat st;
+            if (fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW))
+                return CRACK_DTYPE_OTHER;
+            type = IFTODT(st.st_mode);
+        }
+
+        switch (type) {
+            case DT_DIR: return CRACK_DTYPE_DIR;
+            case DT_REG: return CRACK_DTYPE_FILE;
+            case DT_LNK: return CRACK_DTYPE_LINK;
+            default: return CRACK_DTYPE_OTHER;
+        }
+    }
+}
+
+DirStream *openDirStreamAt(int dirfd, const char *name) {
+    int fd = openat(dirfd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1)
+        return NULL;
+
+    DirStream *d = (DirStream *)malloc(sizeof(DirStream));
+    assert(d && "bad malloc");
+    d->fd = fd;
+    d->pos = d->end = 0;
+#ifndef __linux__
+    d->stream = fdopendir(fd);
+    if (!d->stream) {
+        close(fd);
+        free(d);
+        return NULL;
+    }
+#endif
+    return d;
+}
+
+DirStream *openDirStream(const char *name) {
+    return openDirStreamAt(AT_FDCWD, name);
+}
+
+// Reads the next entry, skipping "." and "..".  Returns 1 if there is an
+// entry, 0 at the end of the directory and -1 on error (check errno).
+int readDirStream(DirStream *d) {
+    assert(d && "null dir stream pointer");
+
+    while (true) {
+#ifdef __linux__
+        if (d->pos >= d->end) {
+            long count = syscall(SYS_getdents64, d->fd, d->buf,
+                                 sizeof(d->buf)
+                                 );
+            if (count <= 0)
+                return count ? -1 : 0;
+            d->pos = 0;
+            d->end = count;
+        }
+
+        LinuxDirent64 *entry = (LinuxDirent64 *)(d->buf + d->pos);
+        d->pos += entry->d_reclen;
+        const char *name = entry->d_name;
+        unsigned char type = entry->d_type;
+#else
+        errno = 0;
+        dirent *entry = ::readdir(d->stream);
+        if (!entry)
+            return errno ? -1 : 0;
+        const char *name = entry->d_name;
+        unsigned char type = entry->d_type;
+#endif
+        if (isSpecial(name))
+            continue;
+
+        d->currentEntry.name = name;
+        d->currentEntry.type = getEntryType(d->fd, name, type);
+        return 1;
+    }
+}
+
+DirEntry *getDirStreamEntry(DirStream *d) {
+    assert(d && "null dir stream pointer");
+    return &d->currentEntry;
+}
+
+int getDirStreamFD(DirStream *d) {
+    assert(d && "null dir stream pointer");
+    return d->fd;
+}
+
+int closeDirStream(DirStream *d) {
+    assert(d && "null dir stream pointer");
+#ifdef __linux__
+    int rc = close(d->fd);
+#else
+    int rc = ::closedir(d->stream);
+#endif
+    free(d);
+    return rc;
+}
+
+bool DirStream_toBool(DirStream *d) {
+    return d;
+}
+
+class TreeWalker {
+    public:
+
+        // The entries of one directory.  'paths' contains the null
+        // terminated full paths of all of the entries.
+        struct Batch {
+            std::vector<char> paths;
+            std::vector<std::pair<size_t, int> > entries;
+        };
+
+    private:
+        pthread_mutex_t lock;
+
+        // signaled when there are directories to read (or when the walk is
+        // done), when there is room in the batch queue and when there are
+        // batches to consume.
+        pthread_cond_t workAvailable, spaceAvailable, batchAvailable;
+
+        // directories waiting to be read.
+        std::deque<std::string> dirs;
+
+        // batches waiting to be consumed.
+        std::deque<Batch *> batches;
+
+        // the maximum number of queued batches, workers wait for the reader
+        // when there are more than this.
+        size_t maxBatches;
+
+        // number of workers currently reading a directory.
+        int busy;
+
+        bool stopped;
+        std::vector<pthread_t> threads;
+
+        Batch *current;
+        size_t index;
+        DirEntry currentEntry;
+
+        bool done() const {
+            return dirs.empty() && !busy;
+        }
+
+        // Reads the directory 'path' into a new batch, adds its
+        // subdirectories to 'subdirs'.
+        static Batch *readDir(const std::string &path,
+                              std::vector<std::string> &subdirs
+                              ) {
+            DirStream *d = openDirStream(path.empty() ? "/" : path.c_str());
+            if (!d)
+                return 0;
+
+            Batch *batch = new Batch();
+            while (readDirStream(d) > 0) {
+                DirEntry *entry = &d->currentEntry;
+                size_t start = batch->paths.size();
+                batch->paths.insert(batch->paths.end(), path.begin(),
+                                    path.end()
+                                    );
+                batch->paths.push_back('/');
+                batch->paths.insert(batch->paths.end(), entry->name,
+                                    entry->name + strlen(entry->name) + 1
+                                    );
+                batch->entries.push_back(std::make_pair(start, entry->type));
+                if (entry->type == CRACK_DTYPE_DIR)
+                    subdirs.push_back(&batch->paths[start]);
+            }
+            closeDirStream(d);
+            return batch;
+        }
+
+        void work() {
+            std::vector<std::string> subdirs;
+            pthread_mutex_lock(&lock);
+            while (true) {
+                while (!stopped && dirs.empty() && busy)
+                    pthread_cond_wait(&workAvailable, &lock);
+                if (stopped || done())
+                    break;
+
+                std::string path = dirs.front();
+                dirs.pop_front();
+                ++busy;
+                pthread_mutex_unlock(&lock);
+
+                subdirs.clear();
+                Batch *batch = readDir(path, subdirs);
+
+                pthread_mutex_lock(&lock);
+                dirs.insert(dirs.end(), subdirs.begin(), subdirs.end());
+                if (batch && batch->entries.empty()) {
+                    delete batch;
+                } else if (batch) {
+                    while (!stopped && batches.size() >= maxBatches)
+                        pthread_cond_wait(&spaceAvailable, &lock);
+                    batches.push_back(batch);
+                }
+                --busy;
+                pthread_cond_broadcast(&workAvailable);
+                pthread_cond_signal(&batchAvailable);
+            }
+            pthread_cond_broadcast(&workAvailable);
+            pthread_cond_signal(&batchAvailable);
+            pthread_mutex_unlock(&lock);
+        }
+
+        static void *runWorker(void *walker) {
+            static_cast<TreeWalker *>(walker)->work();
+            return 0;
+        }
+
+    public:
+        TreeWalker(const char *root, int threadCount) :
+            busy(0),
+            stopped(false),
+            current(0),
+            index(0) {
+
+            if (threadCount <= 0)
+                threadCount = sysconf(_SC_NPROCESSORS_ONLN);
+            if (threadCount <= 0)
+                threadCount = 1;
+            maxBatches = threadCount * 64;
+
+            pthread_mutex_init(&lock, 0);
+            pthread_cond_init(&workAvailable, 0);
+            pthread_cond_init(&spaceAvailable, 0);
+            pthread_cond_init(&batchAvailable, 0);
+            dirs.push_back(root);
+
+            for (int i = 0; i < threadCount; ++i) {
+                pthread_t thread;
+                if (!pthread_create(&thread, 0, runWorker, this))
+                    threads.push_back(thread);
+            }
+
+            // if we couldn't start any threads, do the walk in this one
+            // (without a limit on the batch queue, nothing is consuming it).
+            if (threads.empty()) {
+                maxBatches = batches.max_size();
+                work();
+            }
+        }
+
+        ~TreeWalker() {
+            pthread_mutex_lock(&lock);
+            stopped = true;
+            pthread_cond_broadcast(&workAvailable);
+            pthread_cond_broadcast(&spaceAvailable);
+            pthread_mutex_unlock(&lock);
+
+            for (size_t i = 0; i < threads.size(); ++i)
+                pthread_join(threads[i], 0);
+
+            delete current;
+            for (size_t i = 0; i < batches.size(); ++i)
+                delete batches[i];
+
+            pthread_cond_destroy(&batchAvailable);
+            pthread_cond_destroy(&spaceAvailable);
+            pthread_cond_destroy(&workAvailable);
+            pthread_mutex_destroy(&lock);
+        }
+
+        // Advances to the next entry, returns false at the end of the walk.
+        bool next() {
+            if (current && ++index < current->entries.size()) {
+                setEntry();
+                return true;
+            }
+
+            delete current;
+            current = 0;
+
+            pthread_mutex_lock(&lock);
+            while (batches.empty() && !done())
+                pthread_cond_wait(&batchAvailable, &lock);
+            if (!batches.empty()) {
+                current = batches.front();
+                batches.pop_front();
+                pthread_cond_signal(&spaceAvailable);
+            }
+            pthread_mutex_unlock(&lock);
+
+            if (!current)
+                return false;
+            index = 0;
+            setEntry();
+            return true;
+        }
+
+        void setEntry() {
+            currentEntry.name = &current->paths[current->entries[index].first];
+            currentEntry.type = current->entries[index].second;
+        }
+
+        DirEntry *getEntry() { return &currentEntry; }
+};
+
+// Starts a walk of all of the files and directories under 'root' (not
+// including root itself) using 'threads' worker threads (the number of CPUs
+// if 'threads' is zero).  Symbolic links are not followed.  Entries are
+// produced in no particular order.
+TreeWalker *openTreeWalker(const char *root, int threads) {
+    return new TreeWalker(root, threads);
+}
+
+// Advances to the next entry, returns 0 at the end of the walk.
+int readTreeWalker(TreeWalker *walker) {
+    assert(walker && "null tree walker pointer");
+    return walker->next();
+}
+
+// Returns the current entry.  Its name is the full path of the entry and is
+// only valid until the next call to readTreeWalker().
+DirEntry *getTreeWalkerEntry(TreeWalker *walker) {
+    assert(walker && "null tree walker pointer");
+    return walker->getEntry();
+}
+
+int closeTreeWalker(TreeWalker *walker) {
+    delete walker;
+    return 0;
+}
+
+bool TreeWalker_toBool(TreeWalker *walker) {
+    return walker;
+}
+
 }} // namespace crack::runtime
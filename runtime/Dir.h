@@ -18,6 +18,7 @@ namespace crack { namespace runtime {
 #define CRACK_DTYPE_DIR   1
 #define CRACK_DTYPE_FILE  2
 #define CRACK_DTYPE_OTHER 3
+#define CRACK_DTYPE_LINK  4
 
 // mirrored in crack
 typedef struct {
@@ -32,6 +33,28 @@ typedef struct {
     DirEntry currentEntry;
 } Dir;
 
+// Size of the buffer that DirStream reads directory entries into.
+#define CRACK_DIRSTREAM_BUFSIZE 32768
+
+// A directory read in large batches of entries with a single system call
+// (getdents64 on linux) rather than one entry at a time.  Unlike Dir, the
+// entry type is never "unknown": if the filesystem doesn't supply it, the
+// entry is lstat'ed relative to the directory fd.  opaque to crack.
+typedef struct {
+    int fd;
+    int pos, end;
+    DirEntry currentEntry;
+#ifndef __linux__
+    DIR *stream;
+#endif
+    char buf[CRACK_DIRSTREAM_BUFSIZE];
+} DirStream;
+
+// A parallel walk of a directory tree.  Worker threads read the directories
+// and queue batches of entries (with their full paths), the reader consumes
+// them with readTreeWalker().  opaque to crack.
+class TreeWalker;
+
 // exported interface
 Dir* opendir(const char* name);
 DirEntry* getDirEntry(Dir* d);
@@ -43,6 +66,20 @@ int fnmatch(const char* pattern, const char* string);
 bool Dir_toBool(Dir *dir);
 void *Dir_toVoidptr(Dir *dir);
 
+DirStream *openDirStream(const char *name);
+DirStream *openDirStreamAt(int dirfd, const char *name);
+int readDirStream(DirStream *d);
+DirEntry *getDirStreamEntry(DirStream *d);
+int getDirStreamFD(DirStream *d);
+int closeDirStream(DirStream *d);
+bool DirStream_toBool(DirStream *d);
+
+TreeWalker *openTreeWalker(const char *root, int threads);
+int readTreeWalker(TreeWalker *walker);
+DirEntry *getTreeWalkerEntry(TreeWalker *walker);
+int closeTreeWalker(TreeWalker *walker);
+bool TreeWalker_toBool(TreeWalker *walker);
+
 }} // namespace crack::ext
 
 #endif // _runtime_Dir_h_
@@ -11,6 +11,7 @@
 
 #include <stdlib.h>
 #include <assert.h>
+#include <pthread.h>
 #include <iostream>
 #include <dlfcn.h>
 
@@ -23,16 +24,25 @@ using namespace crack::runtime;
 
 namespace crack { namespace runtime {
 
-// per-thread exception object variable and a "once" variable to allow us to 
-// initialize it.
+// Each thread allocates a single exception record the first time it throws 
+// and reuses it for every exception after that, so throwing doesn't touch 
+// the heap.  "threadException" is the fast path to the record, the pthread 
+// key exists so that we can release it when the thread terminates.
+static __thread _Unwind_Exception *threadException = 0;
 static pthread_key_t exceptionObjectKey;
 static pthread_once_t exceptionObjectKeyOnce = PTHREAD_ONCE_INIT;
 
-void deleteException(_Unwind_Exception *exc) {
-    if (runtimeHooks.exceptionReleaseFunc)
+// Releases the crack exception object held by the record.  The record is 
+// inactive after this.
+static void releaseException(_Unwind_Exception *exc) {
+    if (exc->user_data && runtimeHooks.exceptionReleaseFunc)
         runtimeHooks.exceptionReleaseFunc(exc->user_data);
+    exc->user_data = 0;
+}
+
+void deleteException(_Unwind_Exception *exc) {
+    releaseException(exc);
     delete exc;
-    pthread_setspecific(crack::runtime::exceptionObjectKey, 0);
 }
 
 void initExceptionObjectKey() {
@@ -85,40 +95,44 @@ extern "C" _Unwind_Reason_Code __CrackExceptionPersonality(
 static void __CrackExceptionCleanup(_Unwind_Reason_Code reason,
                                     struct _Unwind_Exception *exc
                                     ) {
-    if (--exc->ref_count == 0) {
-        crack::runtime::deleteException(exc);
-    }
+    // we don't free the record, it gets reused for the next exception.
+    if (--exc->ref_count == 0)
+        crack::runtime::releaseException(exc);
 }
 
-
-/** Function called by the "throw" statement. */
-extern "C" void __CrackThrow(void *crackExceptionObject) {
+// Allocates the exception record for the current thread.
+static _Unwind_Exception *createThreadException() {
     pthread_once(&exceptionObjectKeyOnce, 
                  crack::runtime::initExceptionObjectKey
                  );
-    _Unwind_Exception *uex =
-        reinterpret_cast<_Unwind_Exception *>(
-            pthread_getspecific(crack::runtime::exceptionObjectKey)
-        );
-    if (uex) {
-        // we don't need an atomic reference count for these, they are thread 
-        // specific.
-        ++uex->ref_count;
-        
-        // release the original exception object XXX need to give the crack 
-        // library the option to associate the old exception with the new one.
-        if (runtimeHooks.exceptionReleaseFunc)
-            runtimeHooks.exceptionReleaseFunc(uex->user_data);
-    } else {
-        // XXX it's possible for this to be called when there is a non-crack 
-        // exception active.  In that case, the results are undefined.
-        uex = new _Unwind_Exception();
-        uex->exception_class = crackClassId;
-        uex->exception_cleanup = __CrackExceptionCleanup;
-        uex->ref_count = 1;
-        int rc = pthread_setspecific(crack::runtime::exceptionObjectKey, uex);
-        assert(rc == 0 && "unable to store exception key");
+    _Unwind_Exception *uex = new _Unwind_Exception();
+    uex->exception_class = crackClassId;
+    uex->exception_cleanup = __CrackExceptionCleanup;
+    uex->ref_count = 0;
+    uex->user_data = 0;
+    int rc = pthread_setspecific(crack::runtime::exceptionObjectKey, uex);
+    assert(rc == 0 && "unable to store exception key");
+    crack::runtime::threadException = uex;
+    return uex;
+}
+
+/** Function called by the "throw" statement. */
+extern "C" void __CrackThrow(void *crackExceptionObject) {
+    _Unwind_Exception *uex = crack::runtime::threadException;
+    if (!uex)
+        uex = createThreadException();
+
+    // we don't need an atomic reference count for these, they are thread 
+    // specific.
+    if (uex->ref_count++) {
+        // there's already an active exception: release the original 
+        // exception object XXX need to give the crack library the option to 
+        // associate the old exception with the new one.
+        crack::runtime::releaseException(uex);
     }
+
+    // XXX it's possible for this to be called when there is a non-crack 
+    // exception active.  In that case, the results are undefined.
     uex->user_data = crackExceptionObject;
     _Unwind_Reason_Code urc;
     if (urc = _Unwind_RaiseException(uex)) {
@@ -164,13 +178,10 @@ extern "C" void __CrackBadCast(void *curType, void *newType) {
 /** Called at every stack frame during an exception unwind. */
 extern "C" void __CrackExceptionFrame() {
     if (runtimeHooks.exceptionFrameFunc) {
-        _Unwind_Exception *uex =
-            reinterpret_cast<_Unwind_Exception *>(
-                pthread_getspecific(crack::runtime::exceptionObjectKey)
-            );
+        _Unwind_Exception *uex = crack::runtime::threadException;
         
         // if this is a crack exception, call the exception frame hook.
-        if (uex)
+        if (uex && uex->user_data)
             runtimeHooks.exceptionFrameFunc(uex->user_data, uex->last_ip);
     }
 }                               
@@ -179,11 +190,8 @@ extern "C" void __CrackExceptionFrame() {
  * Returns true if the exception was a crack exception.
  */
 extern "C" bool __CrackUncaughtException() {
-    _Unwind_Exception *uex =
-        reinterpret_cast<_Unwind_Exception *>(
-            pthread_getspecific(crack::runtime::exceptionObjectKey)
-        );
-    if (uex && uex->exception_class == crackClassId) {
+    _Unwind_Exception *uex = crack::runtime::threadException;
+    if (uex && uex->user_data) {
         if (runtimeHooks.exceptionUncaughtFunc)
             runtimeHooks.exceptionUncaughtFunc(uex->user_data);
         return true;
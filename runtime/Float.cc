@@ -0,0 +1,614 @@
+// Runtime support for float <-> string conversions
+// Copyright 2012 Google Inc.
+//
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// Formatting is an implementation of Florian Loitsch's Grisu2 algorithm
+// ("Printing Floating-Point Numbers Quickly and Accurately with Integers",
+// PLDI 2010), which always produces a string that reads back to the same
+// value and almost always the shortest such string.  Parsing uses Clinger's
+// fast path for numbers whose mantissa and power of ten are exactly
+// representable as doubles.
+
+#include "Float.h"
+
+#include <assert.h>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace crack { namespace runtime {
+
+namespace {
+
+// A floating point number with a 64 bit mantissa and no hidden bit,
+// representing f * 2^e.
+struct DiyFp {
+    uint64_t f;
+    int e;
+
+    DiyFp(uint64_t f, int e) : f(f), e(e) {}
+
+    static DiyFp sub(const DiyFp &x, const DiyFp &y) {
+        assert(x.e == y.e && x.f >= y.f);
+        return DiyFp(x.f - y.f, x.e);
+    }
+
+    // Returns the upper 64 bits of the product, rounded.
+    static DiyFp mul(const DiyFp &x, const DiyFp &y) {
+        uint64_t xLo = x.f & 0xFFFFFFFFu, xHi = x.f >> 32;
+        uint64_t yLo = y.f & 0xFFFFFFFFu, yHi = y.f >> 32;
+
+        uint64_t p0 = xLo * yLo;
+        uint64_t p1 = xLo * yHi;
+        uint64_t p2 = xHi * yLo;
+        uint64_t p3 = xHi * yHi;
+
+        uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+        q += uint64_t(1) << 31;
+        return DiyFp(p3 + (p2 >> 32) + (p1 >> 32) + (q >> 32),
+                     x.e + y.e + 64
+                     );
+    }
+
+    static DiyFp normalize(DiyFp x) {
+        while (!(x.f >> 63)) {
+            x.f <<= 1;
+            --x.e;
+        }
+        return x;
+    }
+
+    static DiyFp normalizeTo(const DiyFp &x, int e) {
+        return DiyFp(x.f << (x.e - e), e);
+    }
+};
+
+// The normalized value and its normalized rounding boundaries m- and m+
+// (which share the exponent of m+).
+struct Boundaries {
+    DiyFp w, minus, plus;
+    Boundaries(const DiyFp &w, const DiyFp &minus, const DiyFp &plus) :
+        w(w), minus(minus), plus(plus) {
+    }
+};
+
+// Computes the boundaries of a positive finite value from its raw biased
+// exponent and fraction bits.  'precision' is the number of mantissa bits
+// including the hidden bit.
+Boundaries computeBoundaries(uint64_t exponentBits, uint64_t fraction,
+                             int precision,
+                             int maxExponent
+                             ) {
+    int bias = maxExponent - 1 + (precision - 1);
+    int minExp = 1 - bias;
+    uint64_t hiddenBit = uint64_t(1) << (precision - 1);
+
+    DiyFp v = exponentBits ? 
+                DiyFp(fraction + hiddenBit, int(exponentBits) - bias) :
+                DiyFp(fraction, minExp);
+
+    // the lower boundary is closer if the value is a power of two (other
+    // than the smallest normal, whose predecessor is a denormal)
+    bool lowerIsCloser = !fraction && exponentBits > 1;
+    DiyFp mPlus(2 * v.f + 1, v.e - 1);
+    DiyFp mMinus = lowerIsCloser ? DiyFp(4 * v.f - 1, v.e - 2) :
+                                   DiyFp(2 * v.f - 1, v.e - 1);
+
+    DiyFp wPlus = DiyFp::normalize(mPlus);
+    return Boundaries(DiyFp::normalize(v), DiyFp::normalizeTo(mMinus, wPlus.e),
+                      wPlus
+                      );
+}
+
+Boundaries computeBoundaries(double val) {
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return computeBoundaries(bits >> 52, bits & ((uint64_t(1) << 52) - 1), 53,
+                             DBL_MAX_EXP
+                             );
+}
+
+Boundaries computeBoundaries(float val) {
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return computeBoundaries(bits >> 23, bits & ((1u << 23) - 1), 24,
+                             FLT_MAX_EXP
+                             );
+}
+
+// The target range for the binary exponent of the scaled value, so the 
+// integral part fits in 32 bits.
+const int minTargetExp = -60;
+const int maxTargetExp = -32;
+
+// 10^k, normalized and rounded to 64 bits, for k from -300 to 324 in steps
+// of 8: {f, e, k} with 10^k ~= f * 2^e.
+struct CachedPower {
+    uint64_t f;
+    int e;
+    int k;
+};
+
+const CachedPower cachedPowers[] = {
+    { 0xAB70FE17C79AC6CAULL, -1060,  -300 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034,  -292 },
+    { 0xBE5691EF416BD60CULL, -1007,  -284 },
+    { 0x8DD01FAD907FFC3CULL,  -980,  -276 },
+    { 0xD3515C2831559A83ULL,  -954,  -268 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927,  -260 },
+    { 0xEA9C227723EE8BCBULL,  -901,  -252 },
+    { 0xAECC49914078536DULL,  -874,  -244 },
+    { 0x823C12795DB6CE57ULL,  -847,  -236 },
+    { 0xC21094364DFB5637ULL,  -821,  -228 },
+    { 0x9096EA6F3848984FULL,  -794,  -220 },
+    { 0xD77485CB25823AC7ULL,  -768,  -212 },
+    { 0xA086CFCD97BF97F4ULL,  -741,  -204 },
+    { 0xEF340A98172AACE5ULL,  -715,  -196 },
+    { 0xB23867FB2A35B28EULL,  -688,  -188 },
+    { 0x84C8D4DFD2C63F3BULL,  -661,  -180 },
+    { 0xC5DD44271AD3CDBAULL,  -635,  -172 },
+    { 0x936B9FCEBB25C996ULL,  -608,  -164 },
+    { 0xDBAC6C247D62A584ULL,  -582,  -156 },
+    { 0xA3AB66580D5FDAF6ULL,  -555,  -148 },
+    { 0xF3E2F893DEC3F126ULL,  -529,  -140 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502,  -132 },
+    { 0x87625F056C7C4A8BULL,  -475,  -124 },
+    { 0xC9BCFF6034C13053ULL,  -449,  -116 },
+    { 0x964E858C91BA2655ULL,  -422,  -108 },
+    { 0xDFF9772470297EBDULL,  -396,  -100 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369,   -92 },
+    { 0xF8A95FCF88747D94ULL,  -343,   -84 },
+    { 0xB94470938FA89BCFULL,  -316,   -76 },
+    { 0x8A08F0F8BF0F156BULL,  -289,   -68 },
+    { 0xCDB02555653131B6ULL,  -263,   -60 },
+    { 0x993FE2C6D07B7FACULL,  -236,   -52 },
+    { 0xE45C10C42A2B3B06ULL,  -210,   -44 },
+    { 0xAA242499697392D3ULL,  -183,   -36 },
+    { 0xFD87B5F28300CA0EULL,  -157,   -28 },
+    { 0xBCE5086492111AEBULL,  -130,   -20 },
+    { 0x8CBCCC096F5088CCULL,  -103,   -12 },
+    { 0xD1B71758E219652CULL,   -77,    -4 },
+    { 0x9C40000000000000ULL,   -50,     4 },
+    { 0xE8D4A51000000000ULL,   -24,    12 },
+    { 0xAD78EBC5AC620000ULL,     3,    20 },
+    { 0x813F3978F8940984ULL,    30,    28 },
+    { 0xC097CE7BC90715B3ULL,    56,    36 },
+    { 0x8F7E32CE7BEA5C70ULL,    83,    44 },
+    { 0xD5D238A4ABE98068ULL,   109,    52 },
+    { 0x9F4F2726179A2245ULL,   136,    60 },
+    { 0xED63A231D4C4FB27ULL,   162,    68 },
+    { 0xB0DE65388CC8ADA8ULL,   189,    76 },
+    { 0x83C7088E1AAB65DBULL,   216,    84 },
+    { 0xC45D1DF942711D9AULL,   242,    92 },
+    { 0x924D692CA61BE758ULL,   269,   100 },
+    { 0xDA01EE641A708DEAULL,   295,   108 },
+    { 0xA26DA3999AEF774AULL,   322,   116 },
+    { 0xF209787BB47D6B85ULL,   348,   124 },
+    { 0xB454E4A179DD1877ULL,   375,   132 },
+    { 0x865B86925B9BC5C2ULL,   402,   140 },
+    { 0xC83553C5C8965D3DULL,   428,   148 },
+    { 0x952AB45CFA97A0B3ULL,   455,   156 },
+    { 0xDE469FBD99A05FE3ULL,   481,   164 },
+    { 0xA59BC234DB398C25ULL,   508,   172 },
+    { 0xF6C69A72A3989F5CULL,   534,   180 },
+    { 0xB7DCBF5354E9BECEULL,   561,   188 },
+    { 0x88FCF317F22241E2ULL,   588,   196 },
+    { 0xCC20CE9BD35C78A5ULL,   614,   204 },
+    { 0x98165AF37B2153DFULL,   641,   212 },
+    { 0xE2A0B5DC971F303AULL,   667,   220 },
+    { 0xA8D9D1535CE3B396ULL,   694,   228 },
+    { 0xFB9B7CD9A4A7443CULL,   720,   236 },
+    { 0xBB764C4CA7A44410ULL,   747,   244 },
+    { 0x8BAB8EEFB6409C1AULL,   774,   252 },
+    { 0xD01FEF10A657842CULL,   800,   260 },
+    { 0x9B10A4E5E9913129ULL,   827,   268 },
+    { 0xE7109BFBA19C0C9DULL,   853,   276 },
+    { 0xAC2820D9623BF429ULL,   880,   284 },
+    { 0x80444B5E7AA7CF85ULL,   907,   292 },
+    { 0xBF21E44003ACDD2DULL,   933,   300 },
+    { 0x8E679C2F5E44FF8FULL,   960,   308 },
+    { 0xD433179D9C8CB841ULL,   986,   316 },
+    { 0x9E19DB92B4E31BA9ULL,  1013,   324 },
+};
+
+const int cachedPowersMinDecExp = -300;
+const int cachedPowersDecStep = 8;
+
+// Returns a cached power c = 10^k such that the binary exponent of c * 2^e
+// lies in [minTargetExp, maxTargetExp].
+const CachedPower &getCachedPower(int e) {
+    // k = ceil((minTargetExp - e - 1) * log10(2)), 78913 / 2^18 being a
+    // close enough approximation of log10(2) over the exponent range.
+    int f = minTargetExp - e - 1;
+    int k = (f * 78913) / (1 << 18) + (f > 0);
+    int index = (-cachedPowersMinDecExp + k + (cachedPowersDecStep - 1)) /
+                cachedPowersDecStep;
+    assert(index >= 0 && 
+           index < int(sizeof(cachedPowers) / sizeof(CachedPower))
+           );
+    const CachedPower &cached = cachedPowers[index];
+    assert(minTargetExp <= cached.e + e + 64);
+    assert(cached.e + e + 64 <= maxTargetExp);
+    return cached;
+}
+
+// Returns the number of decimal digits in n and stores the largest power of
+// ten not greater than n in 'pow10'.
+int findLargestPow10(uint32_t n, uint32_t &pow10) {
+    static const uint32_t powers[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000
+    };
+    int digits = 10;
+    while (digits > 1 && n < powers[digits - 1])
+        --digits;
+    pow10 = powers[digits - 1];
+    return digits;
+}
+
+// Moves the last digit of the buffer closer to the exact value while it
+// stays inside the rounding interval.
+void grisuRound(char *buf, int len, uint64_t dist, uint64_t delta,
+                uint64_t rest, 
+                uint64_t tenK
+                ) {
+    while (rest < dist && delta - rest >= tenK &&
+           (rest + tenK < dist || dist - rest > rest + tenK - dist)
+           ) {
+        --buf[len - 1];
+        rest += tenK;
+    }
+}
+
+// Generates the digits of w, stopping as soon as the result is inside the
+// interval [mMinus, mPlus].
+void grisuDigitGen(char *buf, int &len, int &decimalExp, const DiyFp &mMinus,
+                   const DiyFp &w, 
+                   const DiyFp &mPlus
+                   ) {
+    uint64_t delta = DiyFp::sub(mPlus, mMinus).f;
+    uint64_t dist = DiyFp::sub(mPlus, w).f;
+
+    // split mPlus into integral (p1) and fractional (p2) parts.
+    int shift = -mPlus.e;
+    uint64_t one = uint64_t(1) << shift;
+    uint32_t p1 = uint32_t(mPlus.f >> shift);
+    uint64_t p2 = mPlus.f & (one - 1);
+
+    uint32_t pow10;
+    int n = findLargestPow10(p1, pow10);
+    while (n > 0) {
+        buf[len++] = char('0' + p1 / pow10);
+        p1 %= pow10;
+        --n;
+
+        uint64_t rest = (uint64_t(p1) << shift) + p2;
+        if (rest <= delta) {
+            decimalExp += n;
+            grisuRound(buf, len, dist, delta, rest, uint64_t(pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    while (true) {
+        p2 *= 10;
+        buf[len++] = char('0' + (p2 >> shift));
+        p2 &= one - 1;
+        ++m;
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta)
+            break;
+    }
+    decimalExp -= m;
+    grisuRound(buf, len, dist, delta, p2, one);
+}
+
+// Writes the digits of a positive value to 'buf' and returns their count,
+// the value being digits * 10^decimalExp.
+int grisu2(char *buf, int &decimalExp, const Boundaries &b) {
+    const CachedPower &cached = getCachedPower(b.plus.e);
+    DiyFp c(cached.f, cached.e);
+
+    DiyFp w = DiyFp::mul(b.w, c);
+    DiyFp wMinus = DiyFp::mul(b.minus, c);
+    DiyFp wPlus = DiyFp::mul(b.plus, c);
+
+    // shrink the interval by one ulp on each side to allow for the error in
+    // the cached power.
+    DiyFp mMinus(wMinus.f + 1, wMinus.e);
+    DiyFp mPlus(wPlus.f - 1, wPlus.e);
+
+    int len = 0;
+    decimalExp = -cached.k;
+    grisuDigitGen(buf, len, decimalExp, mMinus, w, mPlus);
+    return len;
+}
+
+char *appendExponent(char *buf, int e) {
+    if (e < 0) {
+        e = -e;
+        *buf++ = '-';
+    } else {
+        *buf++ = '+';
+    }
+
+    if (e >= 100) {
+        *buf++ = char('0' + e / 100);
+        e %= 100;
+    }
+    *buf++ = char('0' + e / 10);
+    *buf++ = char('0' + e % 10);
+    return buf;
+}
+
+// Lays out the 'len' digits at the start of 'buf' (value digits *
+// 10^decimalExp) in fixed notation if the decimal point position falls in
+// (minExp, maxExp], and scientific notation otherwise.  Returns the end of
+// the result.
+char *formatDigits(char *buf, int len, int decimalExp, int minExp, 
+                   int maxExp
+                   ) {
+    // n is the position of the decimal point relative to the start of the
+    // digits.
+    int n = len + decimalExp;
+
+    if (len <= n && n <= maxExp) {
+        // digits[000].0
+        memset(buf + len, '0', n - len);
+        buf[n] = '.';
+        buf[n + 1] = '0';
+        return buf + n + 2;
+    }
+
+    if (0 < n && n <= maxExp) {
+        // dig.its
+        memmove(buf + n + 1, buf + n, len - n);
+        buf[n] = '.';
+        return buf + len + 1;
+    }
+
+    if (minExp < n && n <= 0) {
+        // 0.[000]digits
+        memmove(buf + 2 - n, buf, len);
+        buf[0] = '0';
+        buf[1] = '.';
+        memset(buf + 2, '0', -n);
+        return buf + 2 - n + len;
+    }
+
+    // d[.igits]e+nn
+    if (len == 1) {
+        ++buf;
+    } else {
+        memmove(buf + 2, buf + 1, len - 1);
+        buf[1] = '.';
+        buf += len + 1;
+    }
+    *buf++ = 'e';
+    return appendExponent(buf, n - 1);
+}
+
+int copyResult(const char *result, int len, char *buf, unsigned int size) {
+    if (unsigned(len) > size)
+        len = size;
+    memcpy(buf, result, len);
+    if (unsigned(len) < size)
+        buf[len] = 0;
+    return len;
+}
+
+// Formats the special values and zero, returns false for anything else.
+template <typename T>
+bool formatSpecial(T val, char *&out) {
+    if (isnan(val)) {
+        if (signbit(val))
+            *out++ = '-';
+        memcpy(out, "nan", 3);
+        out += 3;
+    } else if (isinf(val)) {
+        if (val < 0)
+            *out++ = '-';
+        memcpy(out, "inf", 3);
+        out += 3;
+    } else if (val == 0) {
+        if (signbit(val))
+            *out++ = '-';
+        memcpy(out, "0.0", 3);
+        out += 3;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+int formatFloat(T val, char *buf, unsigned int size, int maxExp) {
+    char result[40];
+    char *out = result;
+    if (!formatSpecial(val, out)) {
+        if (val < 0) {
+            *out++ = '-';
+            val = -val;
+        }
+        int decimalExp;
+        int len = grisu2(out, decimalExp, computeBoundaries(val));
+        out = formatDigits(out, len, decimalExp, -4, maxExp);
+    }
+    return copyResult(result, out - result, buf, size);
+}
+
+// A decimal number parsed into an integer mantissa and a power of ten.
+struct Decimal {
+    bool negative;
+    uint64_t mantissa;
+    int exponent;
+    
+    // true if there were more significant digits than fit in the mantissa.
+    bool truncated;
+};
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Parses the decimal number at 's' the way strtod() does, storing the end of
+// the number in 'end'.  Returns false for anything other than a plain
+// decimal number (hex, inf and nan are left to the C library).
+bool parseDecimal(const char *s, Decimal &d, const char *&end) {
+    const char *p = s;
+    while (*p == ' ' || (*p >= '\t' && *p <= '\r'))
+        ++p;
+
+    d.negative = false;
+    if (*p == '-' || *p == '+')
+        d.negative = *p++ == '-';
+
+    if (!isDigit(*p) && !(*p == '.' && isDigit(p[1])))
+        return false;
+    if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+        return false;
+
+    // leading zeroes aren't significant.
+    while (*p == '0')
+        ++p;
+
+    d.mantissa = 0;
+    d.exponent = 0;
+    d.truncated = false;
+    int digits = 0;
+    for (; isDigit(*p); ++p) {
+        if (digits < 19) {
+            d.mantissa = d.mantissa * 10 + (*p - '0');
+            ++digits;
+        } else {
+            d.truncated |= *p != '0';
+            ++d.exponent;
+        }
+    }
+
+    if (*p == '.') {
+        ++p;
+        if (!digits) {
+            for (; *p == '0'; ++p)
+                --d.exponent;
+        }
+        for (; isDigit(*p); ++p) {
+            if (digits < 19) {
+                d.mantissa = d.mantissa * 10 + (*p - '0');
+                ++digits;
+                --d.exponent;
+            } else {
+                d.truncated |= *p != '0';
+            }
+        }
+    }
+
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        bool negExp = false;
+        if (*q == '-' || *q == '+')
+            negExp = *q++ == '-';
+        if (isDigit(*q)) {
+            int e = 0;
+            for (; isDigit(*q); ++q)
+                if (e < 100000)
+                    e = e * 10 + (*q - '0');
+            d.exponent += negExp ? -e : e;
+            p = q;
+        }
+    }
+
+    end = p;
+    return true;
+}
+
+// Exactly representable powers of ten.
+const double exactPowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+    1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+locale_t getCLocale() {
+    static locale_t cLocale = newlocale(LC_ALL_MASK, "C", 0);
+    return cLocale;
+}
+
+} // anonymous namespace
+
+int float_str(double val, char *buf, unsigned int size) {
+    return formatFloat(val, buf, size, 15);
+}
+
+int float32_str(float val, char *buf, unsigned int size) {
+    return formatFloat(val, buf, size, 6);
+}
+
+double fast_strtod(const char *s, char **end) {
+    Decimal d;
+    const char *numEnd;
+    if (parseDecimal(s, d, numEnd) && !d.truncated) {
+        if (end)
+            *end = const_cast<char *>(numEnd);
+        if (!d.mantissa)
+            return d.negative ? -0.0 : 0.0;
+
+#if FLT_EVAL_METHOD == 0
+        // Clinger's fast path: the mantissa and the power of ten are both
+        // exact, so a single correctly rounded operation gives the correctly
+        // rounded result.
+        const uint64_t maxExactInt = uint64_t(1) << 53;
+        uint64_t m = d.mantissa;
+        int e = d.exponent;
+
+        // move excess powers of ten into the mantissa while it stays exact.
+        while (e > 22 && m <= maxExactInt / 10) {
+            m *= 10;
+            --e;
+        }
+
+        if (m <= maxExactInt && e >= -22 && e <= 22) {
+            double result = e < 0 ? double(m) / exactPowers[-e] :
+                                    double(m) * exactPowers[e];
+            return d.negative ? -result : result;
+        }
+#endif
+    }
+
+    return strtod_l(s, end, getCLocale());
+}
+
+float fast_strtof(const char *s, char **end) {
+    Decimal d;
+    const char *numEnd;
+    if (parseDecimal(s, d, numEnd) && !d.truncated) {
+        if (end)
+            *end = const_cast<char *>(numEnd);
+        if (!d.mantissa)
+            return d.negative ? -0.0f : 0.0f;
+
+#if FLT_EVAL_METHOD == 0
+        if (d.mantissa <= (uint64_t(1) << 24) && d.exponent >= -10 && 
+            d.exponent <= 10
+            ) {
+            float m = float(d.mantissa);
+            float p = float(exactPowers[d.exponent < 0 ? -d.exponent :
+                                                         d.exponent
+                                        ]
+                            );
+            float result = d.exponent < 0 ? m / p : m * p;
+            return d.negative ? -result : result;
+        }
+#endif
+    }
+
+    return strtof_l(s, end, getCLocale());
+}
+
+}} // namespace crack::runtime
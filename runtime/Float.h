@@ -0,0 +1,33 @@
+// Runtime support for float <-> string conversions
+// Copyright 2012 Google Inc.
+//
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+
+#ifndef _runtime_Float_h_
+#define _runtime_Float_h_
+
+namespace crack { namespace runtime {
+
+// Formats 'val' into 'buf' as the shortest decimal string that reads back
+// as the same value (e.g. "0.1", "1.0", "1.5e+300", "nan", "-inf").
+// Writes at most 'size' bytes, null terminating the result if there is room
+// and returns the number of bytes written.  A buffer of 32 bytes is always
+// sufficient.
+int float_str(double val, char *buf, unsigned int size);
+
+// Like float_str(), but for a single precision value: the result is the
+// shortest string that reads back as the same float32.
+int float32_str(float val, char *buf, unsigned int size);
+
+// Locale independent equivalents of strtod() and strtof().  Most numbers are
+// converted exactly with a single floating point operation, anything else
+// falls back to the C library conversion in the "C" locale.
+double fast_strtod(const char *s, char **end);
+float fast_strtof(const char *s, char **end);
+
+}} // namespace crack::runtime
+
+#endif // _runtime_Float_h_
@@ -0,0 +1,1178 @@
+// Streaming hash and digest functions
+// Copyright 2012 Google Inc.
+//
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// xxHash64, XXH3-128, CRC32C, SHA-1 and SHA-256.  The xxHash functions
+// follow the reference implementation (http://www.xxhash.com) and produce
+// the same values.  CRC32C and the SHA functions check the CPU once and use
+// the SSE4.2 crc32 and SHA-NI instructions when they are available, falling
+// back to portable code otherwise.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+// the SSE4.2 and SHA-NI code is compiled with function target attributes
+// so that the rest of the runtime doesn't require those instruction sets.
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || __GNUC__ > 4 || \
+     (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+# define CRACK_HASH_X86 1
+# include <cpuid.h>
+# include <immintrin.h>
+#endif
+
+namespace {
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline uint32_t toLE32(uint32_t val) { return __builtin_bswap32(val); }
+inline uint64_t toLE64(uint64_t val) { return __builtin_bswap64(val); }
+#else
+inline uint32_t toLE32(uint32_t val) { return val; }
+inline uint64_t toLE64(uint64_t val) { return val; }
+#endif
+
+inline uint32_t readLE32(const uint8_t *p) {
+    uint32_t val;
+    memcpy(&val, p, 4);
+    return toLE32(val);
+}
+
+inline uint64_t readLE64(const uint8_t *p) {
+    uint64_t val;
+    memcpy(&val, p, 8);
+    return toLE64(val);
+}
+
+inline uint32_t readBE32(const uint8_t *p) {
+    return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 |
+           uint32_t(p[2]) << 8 | p[3];
+}
+
+inline void writeBE32(uint8_t *p, uint32_t val) {
+    p[0] = val >> 24;
+    p[1] = val >> 16;
+    p[2] = val >> 8;
+    p[3] = val;
+}
+
+inline void writeBE64(uint8_t *p, uint64_t val) {
+    writeBE32(p, val >> 32);
+    writeBE32(p + 4, uint32_t(val));
+}
+
+inline uint32_t rotl32(uint32_t val, int bits) {
+    return (val << bits) | (val >> (32 - bits));
+}
+
+inline uint32_t rotr32(uint32_t val, int bits) {
+    return (val >> bits) | (val << (32 - bits));
+}
+
+inline uint64_t rotl64(uint64_t val, int bits) {
+    return (val << bits) | (val >> (64 - bits));
+}
+
+inline uint32_t swap32(uint32_t val) { return __builtin_bswap32(val); }
+inline uint64_t swap64(uint64_t val) { return __builtin_bswap64(val); }
+
+#ifdef CRACK_HASH_X86
+enum CPUFeature { cpuSSE42, cpuSHA };
+
+bool cpuHas(CPUFeature feature) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    if (feature == cpuSSE42)
+        return ecx & bit_SSE4_2;
+
+    // SHA-NI also needs the SSSE3 and SSE4.1 shuffles and blends.
+    if (!(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1) ||
+        __get_cpuid_max(0, 0) < 7
+        )
+        return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return ebx & (1 << 29);
+}
+#endif
+
+// xxHash ---------------------------------------------------------------------
+
+const uint32_t PRIME32_1 = 0x9E3779B1U;
+const uint32_t PRIME32_2 = 0x85EBCA77U;
+const uint32_t PRIME32_3 = 0xC2B2AE3DU;
+const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+const uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+const uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+struct XXH64State {
+    uint64_t v[4];
+    uint64_t total;
+    uint8_t mem[32];
+    unsigned int memSize;
+    uint64_t seed;
+};
+
+inline uint64_t xxh64Round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME64_1;
+}
+
+inline uint64_t xxh64Merge(uint64_t acc, uint64_t val) {
+    acc ^= xxh64Round(0, val);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+inline uint64_t xxh64Avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+// 128 bit arithmetic for XXH3.
+struct Hash128 {
+    uint64_t low, high;
+};
+
+inline Hash128 mult64to128(uint64_t a, uint64_t b) {
+    Hash128 result;
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128)a * b;
+    result.low = uint64_t(product);
+    result.high = uint64_t(product >> 64);
+#else
+    uint64_t lolo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF),
+             hilo = (a >> 32) * (b & 0xFFFFFFFF),
+             lohi = (a & 0xFFFFFFFF) * (b >> 32),
+             hihi = (a >> 32) * (b >> 32),
+             cross = (lolo >> 32) + (hilo & 0xFFFFFFFF) + lohi;
+    result.high = (hilo >> 32) + (cross >> 32) + hihi;
+    result.low = (cross << 32) | (lolo & 0xFFFFFFFF);
+#endif
+    return result;
+}
+
+inline uint64_t mul128Fold64(uint64_t a, uint64_t b) {
+    Hash128 product = mult64to128(a, b);
+    return product.low ^ product.high;
+}
+
+inline uint64_t xxh3Avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= PRIME_MX1;
+    return h ^ (h >> 32);
+}
+
+const int XXH3_SECRET_SIZE = 192,
+          XXH3_SECRET_SIZE_MIN = 136,
+          XXH3_STRIPE_LEN = 64,
+          XXH3_SECRET_CONSUME_RATE = 8,
+          XXH3_STRIPES_PER_BLOCK =
+            (XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / XXH3_SECRET_CONSUME_RATE,
+          XXH3_SECRET_LIMIT = XXH3_SECRET_SIZE - XXH3_STRIPE_LEN,
+          XXH3_SECRET_LASTACC_START = 7,
+          XXH3_SECRET_MERGEACCS_START = 11,
+          XXH3_MIDSIZE_MAX = 240,
+          XXH3_MIDSIZE_STARTOFFSET = 3,
+          XXH3_MIDSIZE_LASTOFFSET = 17,
+          XXH3_BUFFER_SIZE = 256;
+
+const uint8_t xxh3Secret[XXH3_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe,
+    0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78,
+    0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e,
+    0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e,
+    0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f,
+    0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3,
+    0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49,
+    0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28,
+    0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+struct XXH3State {
+    uint64_t acc[8];
+    uint8_t secret[XXH3_SECRET_SIZE];
+    uint8_t buffer[XXH3_BUFFER_SIZE];
+    uint64_t seed, total;
+    unsigned int bufferedSize, stripesSoFar;
+};
+
+// the accumulators, 16 byte aligned for the SSE2 loop.
+struct XXH3Acc {
+#ifdef __SSE2__
+    __m128i vec[4];
+    uint64_t *lanes() { return reinterpret_cast<uint64_t *>(vec); }
+#else
+    uint64_t vec[8];
+    uint64_t *lanes() { return vec; }
+#endif
+};
+
+// Mixes one 64 byte stripe into the accumulators.
+inline void xxh3Accumulate512(XXH3Acc &acc, const uint8_t *input,
+                              const uint8_t *secret
+                              ) {
+#ifdef __SSE2__
+    for (int i = 0; i < 4; ++i) {
+        __m128i data = _mm_loadu_si128((const __m128i *)input + i),
+                key = _mm_xor_si128(
+                    data,
+                    _mm_loadu_si128((const __m128i *)secret + i)
+                ),
+                keyHigh = _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)),
+                product = _mm_mul_epu32(key, keyHigh),
+                swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        acc.vec[i] = _mm_add_epi64(product,
+                                   _mm_add_epi64(acc.vec[i], swapped)
+                                   );
+    }
+#else
+    uint64_t *lanes = acc.lanes();
+    for (int i = 0; i < 8; ++i) {
+        uint64_t data = readLE64(input + i * 8),
+                 key = data ^ readLE64(secret + i * 8);
+        lanes[i ^ 1] += data;
+        lanes[i] += (key & 0xFFFFFFFF) * (key >> 32);
+    }
+#endif
+}
+
+// Scrambles the accumulators at the end of a block.
+inline void xxh3Scramble(XXH3Acc &acc, const uint8_t *secret) {
+#ifdef __SSE2__
+    const __m128i prime = _mm_set1_epi32(int(PRIME32_1));
+    for (int i = 0; i < 4; ++i) {
+        __m128i val = _mm_xor_si128(acc.vec[i],
+                                    _mm_srli_epi64(acc.vec[i], 47)
+                                    );
+        val = _mm_xor_si128(val,
+                            _mm_loadu_si128((const __m128i *)secret + i)
+                            );
+        __m128i high = _mm_shuffle_epi32(val, _MM_SHUFFLE(0, 3, 0, 1));
+        acc.vec[i] = _mm_add_epi64(
+            _mm_mul_epu32(val, prime),
+            _mm_slli_epi64(_mm_mul_epu32(high, prime), 32)
+        );
+    }
+#else
+    uint64_t *lanes = acc.lanes();
+    for (int i = 0; i < 8; ++i) {
+        uint64_t val = lanes[i];
+        val ^= val >> 47;
+        val ^= readLE64(secret + i * 8);
+        lanes[i] = val * PRIME32_1;
+    }
+#endif
+}
+
+// Accumulates 'count' stripes, scrambling at the end of every block.
+// 'stripesSoFar' is the position in the current block.
+const uint8_t *xxh3ConsumeStripes(XXH3Acc &acc, unsigned int &stripesSoFar,
+                                  const uint8_t *input, size_t count,
+                                  const uint8_t *secret
+                                  ) {
+    while (count) {
+        size_t n = XXH3_STRIPES_PER_BLOCK - stripesSoFar;
+        if (n > count)
+            n = count;
+        const uint8_t *key = secret + stripesSoFar * XXH3_SECRET_CONSUME_RATE;
+        for (size_t i = 0; i < n; ++i)
+            xxh3Accumulate512(acc, input + i * XXH3_STRIPE_LEN,
+                              key + i * XXH3_SECRET_CONSUME_RATE
+                              );
+        input += n * XXH3_STRIPE_LEN;
+        count -= n;
+        stripesSoFar += n;
+        if (stripesSoFar == XXH3_STRIPES_PER_BLOCK) {
+            xxh3Scramble(acc, secret + XXH3_SECRET_LIMIT);
+            stripesSoFar = 0;
+        }
+    }
+    return input;
+}
+
+uint64_t xxh3MergeAccs(uint64_t *acc, const uint8_t *secret,
+                       uint64_t start
+                       ) {
+    uint64_t result = start;
+    for (int i = 0; i < 4; ++i)
+        result += mul128Fold64(acc[i * 2] ^ readLE64(secret + i * 16),
+                               acc[i * 2 + 1] ^ readLE64(secret + i * 16 + 8)
+                               );
+    return xxh3Avalanche(result);
+}
+
+inline uint64_t xxh3Mix16(const uint8_t *input, const uint8_t *secret,
+                          uint64_t seed
+                          ) {
+    return mul128Fold64(readLE64(input) ^ (readLE64(secret) + seed),
+                        readLE64(input + 8) ^ (readLE64(secret + 8) - seed)
+                        );
+}
+
+inline Hash128 xxh3Mix32(Hash128 acc, const uint8_t *input1,
+                         const uint8_t *input2,
+                         const uint8_t *secret,
+                         uint64_t seed
+                         ) {
+    acc.low += xxh3Mix16(input1, secret, seed);
+    acc.low ^= readLE64(input2) + readLE64(input2 + 8);
+    acc.high += xxh3Mix16(input2, secret + 16, seed);
+    acc.high ^= readLE64(input1) + readLE64(input1 + 8);
+    return acc;
+}
+
+Hash128 xxh3Short128(const uint8_t *input, size_t len, const uint8_t *secret,
+                     uint64_t seed
+                     ) {
+    Hash128 h;
+    if (len == 0) {
+        h.low = xxh64Avalanche(seed ^ readLE64(secret + 64) ^
+                               readLE64(secret + 72));
+        h.high = xxh64Avalanche(seed ^ readLE64(secret + 80) ^
+                                readLE64(secret + 88));
+    } else if (len <= 3) {
+        uint32_t combinedLow = uint32_t(input[0]) << 16 |
+                               uint32_t(input[len >> 1]) << 24 |
+                               uint32_t(input[len - 1]) |
+                               uint32_t(len) << 8;
+        uint32_t combinedHigh = rotl32(swap32(combinedLow), 13);
+        uint64_t flipLow = (readLE32(secret) ^ readLE32(secret + 4)) + seed,
+                 flipHigh = (readLE32(secret + 8) ^ readLE32(secret + 12)) -
+                            seed;
+        h.low = xxh64Avalanche(combinedLow ^ flipLow);
+        h.high = xxh64Avalanche(combinedHigh ^ flipHigh);
+    } else if (len <= 8) {
+        seed ^= uint64_t(swap32(uint32_t(seed))) << 32;
+        uint64_t input64 = readLE32(input) +
+                           (uint64_t(readLE32(input + len - 4)) << 32);
+        uint64_t flip = (readLE64(secret + 16) ^ readLE64(secret + 24)) + seed;
+        h = mult64to128(input64 ^ flip, PRIME64_1 + (len << 2));
+        h.high += h.low << 1;
+        h.low ^= h.high >> 3;
+        h.low ^= h.low >> 35;
+        h.low *= PRIME_MX2;
+        h.low ^= h.low >> 28;
+        h.high = xxh3Avalanche(h.high);
+    } else if (len <= 16) {
+        uint64_t flipLow = (readLE64(secret + 32) ^ readLE64(secret + 40)) -
+                           seed,
+                 flipHigh = (readLE64(secret + 48) ^ readLE64(secret + 56)) +
+                            seed,
+                 inputLow = readLE64(input),
+                 inputHigh = readLE64(input + len - 8);
+        Hash128 m = mult64to128(inputLow ^ inputHigh ^ flipLow, PRIME64_1);
+        m.low += uint64_t(len - 1) << 54;
+        inputHigh ^= flipHigh;
+        m.high += inputHigh +
+                  (inputHigh & 0xFFFFFFFF) * uint64_t(PRIME32_2 - 1);
+        m.low ^= swap64(m.high);
+        h = mult64to128(m.low, PRIME64_2);
+        h.high += m.high * PRIME64_2;
+        h.low = xxh3Avalanche(h.low);
+        h.high = xxh3Avalanche(h.high);
+    } else {
+        Hash128 acc;
+        acc.low = len * PRIME64_1;
+        acc.high = 0;
+        if (len <= 128) {
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96)
+                        acc = xxh3Mix32(acc, input + 48, input + len - 64,
+                                        secret + 96,
+                                        seed
+                                        );
+                    acc = xxh3Mix32(acc, input + 32, input + len - 48,
+                                    secret + 64,
+                                    seed
+                                    );
+                }
+                acc = xxh3Mix32(acc, input + 16, input + len - 32,
+                                secret + 32,
+                                seed
+                                );
+            }
+            acc = xxh3Mix32(acc, input, input + len - 16, secret, seed);
+        } else {
+            size_t i;
+            for (i = 32; i < 160; i += 32)
+                acc = xxh3Mix32(acc, input + i - 32, input + i - 16,
+                                secret + i - 32,
+                                seed
+                                );
+            acc.low = xxh3Avalanche(acc.low);
+            acc.high = xxh3Avalanche(acc.high);
+            for (i = 160; i <= len; i += 32)
+                acc = xxh3Mix32(acc, input + i - 32, input + i - 16,
+                                secret + XXH3_MIDSIZE_STARTOFFSET + i - 160,
+                                seed
+                                );
+            acc = xxh3Mix32(acc, input + len - 16, input + len - 32,
+                            secret + XXH3_SECRET_SIZE_MIN -
+                             XXH3_MIDSIZE_LASTOFFSET - 16,
+                            0 - seed
+                            );
+        }
+        h.low = xxh3Avalanche(acc.low + acc.high);
+        h.high = 0 - xxh3Avalanche(acc.low * PRIME64_1 +
+                                   acc.high * PRIME64_4 +
+                                   (len - seed) * PRIME64_2
+                                   );
+    }
+    return h;
+}
+
+// SHA ------------------------------------------------------------------------
+
+struct SHAState {
+    uint32_t h[8];
+    uint64_t total;
+    uint8_t buf[64];
+    unsigned int bufSize;
+};
+
+typedef void (*SHABlocksFunc)(uint32_t *h, const uint8_t *data,
+                              size_t blocks
+                              );
+
+void sha1BlocksPortable(uint32_t *h, const uint8_t *data, size_t blocks) {
+    uint32_t w[80];
+    for (; blocks; --blocks, data += 64) {
+        for (int i = 0; i < 16; ++i)
+            w[i] = readBE32(data + i * 4);
+        for (int i = 16; i < 80; ++i)
+            w[i] = rotl32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t temp = rotl32(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl32(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+}
+
+const uint32_t sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+void sha256BlocksPortable(uint32_t *h, const uint8_t *data, size_t blocks) {
+    uint32_t w[64];
+    for (; blocks; --blocks, data += 64) {
+        for (int i = 0; i < 16; ++i)
+            w[i] = readBE32(data + i * 4);
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^
+                          (w[i - 15] >> 3),
+                     s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^
+                          (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3],
+                 e = h[4], f = h[5], g = h[6], hh = h[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25),
+                     ch = (e & f) ^ (~e & g),
+                     temp1 = hh + s1 + ch + sha256K[i] + w[i],
+                     s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22),
+                     maj = (a & b) ^ (a & c) ^ (b & c),
+                     temp2 = s0 + maj;
+            hh = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+        h[5] += f;
+        h[6] += g;
+        h[7] += hh;
+    }
+}
+
+#ifdef CRACK_HASH_X86
+
+#define CRACK_SHA_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+
+// Four SHA-1 rounds on message words 'w0', then computes the message words
+// for four groups later from 'w0' through 'w3'.
+#define SHA1_ROUNDS4(func, w0, w1, w2, w3) \
+    e1 = _mm_sha1nexte_epu32(e0, w0); \
+    e0 = abcd; \
+    abcd = _mm_sha1rnds4_epu32(abcd, e1, func); \
+    w0 = _mm_sha1msg2_epu32( \
+        _mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), \
+        w3 \
+    );
+
+CRACK_SHA_TARGET
+void sha1BlocksNI(uint32_t *h, const uint8_t *data, size_t blocks) {
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL,
+                                        0x08090a0b0c0d0e0fULL
+                                        );
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)h),
+                                     0x1B
+                                     ),
+            e = _mm_set_epi32(h[4], 0, 0, 0);
+
+    for (; blocks; --blocks, data += 64) {
+        __m128i abcdSave = abcd, eSave = e, e0, e1,
+            m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data),
+                                  mask
+                                  ),
+            m1 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 16)),
+                mask
+            ),
+            m2 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 32)),
+                mask
+            ),
+            m3 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 48)),
+                mask
+            );
+
+        // the first group adds the message to e directly.
+        e1 = _mm_add_epi32(e, m0);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        m0 = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(m0, m1), m2),
+                                m3
+                                );
+
+        SHA1_ROUNDS4(0, m1, m2, m3, m0)
+        SHA1_ROUNDS4(0, m2, m3, m0, m1)
+        SHA1_ROUNDS4(0, m3, m0, m1, m2)
+        SHA1_ROUNDS4(0, m0, m1, m2, m3)
+        SHA1_ROUNDS4(1, m1, m2, m3, m0)
+        SHA1_ROUNDS4(1, m2, m3, m0, m1)
+        SHA1_ROUNDS4(1, m3, m0, m1, m2)
+        SHA1_ROUNDS4(1, m0, m1, m2, m3)
+        SHA1_ROUNDS4(1, m1, m2, m3, m0)
+        SHA1_ROUNDS4(2, m2, m3, m0, m1)
+        SHA1_ROUNDS4(2, m3, m0, m1, m2)
+        SHA1_ROUNDS4(2, m0, m1, m2, m3)
+        SHA1_ROUNDS4(2, m1, m2, m3, m0)
+        SHA1_ROUNDS4(2, m2, m3, m0, m1)
+        SHA1_ROUNDS4(3, m3, m0, m1, m2)
+        SHA1_ROUNDS4(3, m0, m1, m2, m3)
+        SHA1_ROUNDS4(3, m1, m2, m3, m0)
+        SHA1_ROUNDS4(3, m2, m3, m0, m1)
+        SHA1_ROUNDS4(3, m3, m0, m1, m2)
+
+        e = _mm_sha1nexte_epu32(e0, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128((__m128i *)h, _mm_shuffle_epi32(abcd, 0x1B));
+    h[4] = _mm_extract_epi32(e, 3);
+}
+
+// Four SHA-256 rounds on message words 'w0', then computes the message
+// words for four groups later from 'w0' through 'w3'.
+#define SHA256_ROUNDS4(group, w0, w1, w2, w3) \
+    msg = _mm_add_epi32(w0, \
+                        _mm_loadu_si128((const __m128i *)sha256K + (group)) \
+                        ); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, \
+                                   _mm_shuffle_epi32(msg, 0x0E) \
+                                   ); \
+    w0 = _mm_sha256msg2_epu32( \
+        _mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), \
+                      _mm_alignr_epi8(w3, w2, 4) \
+                      ), \
+        w3 \
+    );
+
+CRACK_SHA_TARGET
+void sha256BlocksNI(uint32_t *h, const uint8_t *data, size_t blocks) {
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                        0x0405060700010203ULL
+                                        );
+
+    // the rounds instructions want the state as ABEF and CDGH.
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)h),
+                                    0xB1
+                                    ),
+            state1 = _mm_shuffle_epi32(
+                _mm_loadu_si128((const __m128i *)(h + 4)),
+                0x1B
+            ),
+            state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; blocks; --blocks, data += 64) {
+        __m128i save0 = state0, save1 = state1, msg,
+            m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data),
+                                  mask
+                                  ),
+            m1 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 16)),
+                mask
+            ),
+            m2 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 32)),
+                mask
+            ),
+            m3 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(data + 48)),
+                mask
+            );
+
+        for (int group = 0; group < 16; group += 4) {
+            SHA256_ROUNDS4(group, m0, m1, m2, m3)
+            SHA256_ROUNDS4(group + 1, m1, m2, m3, m0)
+            SHA256_ROUNDS4(group + 2, m2, m3, m0, m1)
+            SHA256_ROUNDS4(group + 3, m3, m0, m1, m2)
+        }
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i *)h, _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i *)(h + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#endif
+
+SHABlocksFunc selectSHA1() {
+#ifdef CRACK_HASH_X86
+    if (cpuHas(cpuSHA))
+        return sha1BlocksNI;
+#endif
+    return sha1BlocksPortable;
+}
+
+SHABlocksFunc selectSHA256() {
+#ifdef CRACK_HASH_X86
+    if (cpuHas(cpuSHA))
+        return sha256BlocksNI;
+#endif
+    return sha256BlocksPortable;
+}
+
+SHAState *newSHAState(const uint32_t *init, int words) {
+    SHAState *state = (SHAState *)malloc(sizeof(SHAState));
+    memcpy(state->h, init, words * 4);
+    state->total = 0;
+    state->bufSize = 0;
+    return state;
+}
+
+void shaUpdate(SHAState *state, SHABlocksFunc blocks, const uint8_t *data,
+               size_t size
+               ) {
+    state->total += size;
+    if (state->bufSize) {
+        size_t count = 64 - state->bufSize;
+        if (count > size)
+            count = size;
+        memcpy(state->buf + state->bufSize, data, count);
+        state->bufSize += count;
+        data += count;
+        size -= count;
+        if (state->bufSize < 64)
+            return;
+        blocks(state->h, state->buf, 1);
+        state->bufSize = 0;
+    }
+
+    if (size >= 64) {
+        blocks(state->h, data, size / 64);
+        data += size & ~size_t(63);
+        size &= 63;
+    }
+    memcpy(state->buf, data, size);
+    state->bufSize = size;
+}
+
+// Pads a copy of the state, so the caller can keep adding data after
+// getting a digest.
+void shaDigest(const SHAState *state, SHABlocksFunc blocks, uint8_t *digest,
+               int words
+               ) {
+    SHAState final = *state;
+    final.buf[final.bufSize++] = 0x80;
+    if (final.bufSize > 56) {
+        memset(final.buf + final.bufSize, 0, 64 - final.bufSize);
+        blocks(final.h, final.buf, 1);
+        final.bufSize = 0;
+    }
+    memset(final.buf + final.bufSize, 0, 56 - final.bufSize);
+    writeBE64(final.buf + 56, state->total * 8);
+    blocks(final.h, final.buf, 1);
+    for (int i = 0; i < words; ++i)
+        writeBE32(digest + i * 4, final.h[i]);
+}
+
+// CRC32C --------------------------------------------------------------------
+
+// The CRC functions work on the inverted CRC.
+typedef uint32_t (*CRC32CFunc)(uint32_t crc, const uint8_t *data,
+                               size_t size
+                               );
+
+uint32_t crc32cTable[8][256];
+
+// Slicing-by-8 over the Castagnoli polynomial.
+uint32_t crc32cPortable(uint32_t crc, const uint8_t *data, size_t size) {
+    for (; size && (uintptr_t(data) & 7); --size)
+        crc = crc32cTable[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+    for (; size >= 8; size -= 8, data += 8) {
+        uint32_t low = readLE32(data) ^ crc, high = readLE32(data + 4);
+        crc = crc32cTable[7][low & 0xFF] ^
+              crc32cTable[6][(low >> 8) & 0xFF] ^
+              crc32cTable[5][(low >> 16) & 0xFF] ^
+              crc32cTable[4][low >> 24] ^
+              crc32cTable[3][high & 0xFF] ^
+              crc32cTable[2][(high >> 8) & 0xFF] ^
+              crc32cTable[1][(high >> 16) & 0xFF] ^
+              crc32cTable[0][high >> 24];
+    }
+
+    for (; size; --size)
+        crc = crc32cTable[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#ifdef CRACK_HASH_X86
+__attribute__((target("sse4.2")))
+uint32_t crc32cSSE42(uint32_t crc, const uint8_t *data, size_t size) {
+    for (; size && (uintptr_t(data) & 7); --size)
+        crc = _mm_crc32_u8(crc, *data++);
+
+#ifdef __x86_64__
+    uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, data += 8)
+        crc64 = _mm_crc32_u64(crc64, *(const uint64_t *)data);
+    crc = uint32_t(crc64);
+#endif
+    for (; size >= 4; size -= 4, data += 4)
+        crc = _mm_crc32_u32(crc, *(const uint32_t *)data);
+
+    for (; size; --size)
+        crc = _mm_crc32_u8(crc, *data++);
+    return crc;
+}
+#endif
+
+CRC32CFunc selectCRC32C() {
+#ifdef CRACK_HASH_X86
+    if (cpuHas(cpuSSE42))
+        return crc32cSSE42;
+#endif
+
+    for (int i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (crc & 1 ? 0x82F63B78 : 0);
+        crc32cTable[0][i] = crc;
+    }
+    for (int i = 0; i < 256; ++i)
+        for (int slice = 1; slice < 8; ++slice)
+            crc32cTable[slice][i] =
+                crc32cTable[0][crc32cTable[slice - 1][i] & 0xFF] ^
+                (crc32cTable[slice - 1][i] >> 8);
+    return crc32cPortable;
+}
+
+} // anon namespace
+
+namespace crack { namespace runtime {
+
+XXH64State *xxh64_init(uint64_t seed) {
+    XXH64State *state = (XXH64State *)malloc(sizeof(XXH64State));
+    state->v[0] = seed + PRIME64_1 + PRIME64_2;
+    state->v[1] = seed + PRIME64_2;
+    state->v[2] = seed;
+    state->v[3] = seed - PRIME64_1;
+    state->total = 0;
+    state->memSize = 0;
+    state->seed = seed;
+    return state;
+}
+
+void xxh64_update(XXH64State *state, const char *buf, unsigned int size) {
+    const uint8_t *data = (const uint8_t *)buf;
+    state->total += size;
+    if (state->memSize + size < 32) {
+        memcpy(state->mem + state->memSize, data, size);
+        state->memSize += size;
+        return;
+    }
+
+    uint64_t *v = state->v;
+    if (state->memSize) {
+        unsigned int count = 32 - state->memSize;
+        memcpy(state->mem + state->memSize, data, count);
+        for (int i = 0; i < 4; ++i)
+            v[i] = xxh64Round(v[i], readLE64(state->mem + i * 8));
+        data += count;
+        size -= count;
+        state->memSize = 0;
+    }
+
+    for (; size >= 32; size -= 32, data += 32) {
+        v[0] = xxh64Round(v[0], readLE64(data));
+        v[1] = xxh64Round(v[1], readLE64(data + 8));
+        v[2] = xxh64Round(v[2], readLE64(data + 16));
+        v[3] = xxh64Round(v[3], readLE64(data + 24));
+    }
+    memcpy(state->mem, data, size);
+    state->memSize = size;
+}
+
+uint64_t xxh64_digest(XXH64State *state) {
+    const uint64_t *v = state->v;
+    uint64_t h;
+    if (state->total >= 32) {
+        h = rotl64(v[0], 1) + rotl64(v[1], 7) + rotl64(v[2], 12) +
+            rotl64(v[3], 18);
+        for (int i = 0; i < 4; ++i)
+            h = xxh64Merge(h, v[i]);
+    } else {
+        h = state->seed + PRIME64_5;
+    }
+    h += state->total;
+
+    const uint8_t *data = state->mem;
+    unsigned int size = state->memSize;
+    for (; size >= 8; size -= 8, data += 8) {
+        h ^= xxh64Round(0, readLE64(data));
+        h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (size >= 4) {
+        h ^= uint64_t(readLE32(data)) * PRIME64_1;
+        h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+        data += 4;
+        size -= 4;
+    }
+    for (; size; --size) {
+        h ^= *data++ * PRIME64_5;
+        h = rotl64(h, 11) * PRIME64_1;
+    }
+    return xxh64Avalanche(h);
+}
+
+XXH3State *xxh128_init(uint64_t seed) {
+    XXH3State *state = (XXH3State *)malloc(sizeof(XXH3State));
+    static const uint64_t initAcc[8] = {
+        PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3,
+        PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+    };
+    memcpy(state->acc, initAcc, sizeof(initAcc));
+
+    // long inputs use a secret derived from the seed.
+    for (int i = 0; i < XXH3_SECRET_SIZE; i += 16) {
+        uint64_t low = toLE64(readLE64(xxh3Secret + i) + seed),
+                 high = toLE64(readLE64(xxh3Secret + i + 8) - seed);
+        memcpy(state->secret + i, &low, 8);
+        memcpy(state->secret + i + 8, &high, 8);
+    }
+    state->seed = seed;
+    state->total = 0;
+    state->bufferedSize = 0;
+    state->stripesSoFar = 0;
+    return state;
+}
+
+void xxh128_update(XXH3State *state, const char *buf, unsigned int size) {
+    const uint8_t *data = (const uint8_t *)buf, *end = data + size;
+    state->total += size;
+    if (size <= XXH3_BUFFER_SIZE - state->bufferedSize) {
+        memcpy(state->buffer + state->bufferedSize, data, size);
+        state->bufferedSize += size;
+        return;
+    }
+
+    XXH3Acc acc;
+    memcpy(acc.lanes(), state->acc, sizeof(state->acc));
+
+    // the buffer is only consumed when more data follows it, so that the
+    // digest always has the last stripe.
+    if (state->bufferedSize) {
+        unsigned int count = XXH3_BUFFER_SIZE - state->bufferedSize;
+        memcpy(state->buffer + state->bufferedSize, data, count);
+        data += count;
+        xxh3ConsumeStripes(acc, state->stripesSoFar, state->buffer,
+                           XXH3_BUFFER_SIZE / XXH3_STRIPE_LEN,
+                           state->secret
+                           );
+        state->bufferedSize = 0;
+    }
+
+    if (end - data > XXH3_BUFFER_SIZE) {
+        size_t stripes = (end - 1 - data) / XXH3_STRIPE_LEN;
+        data = xxh3ConsumeStripes(acc, state->stripesSoFar, data, stripes,
+                                  state->secret
+                                  );
+
+        // keep the last stripe for digests of less than a stripe of new
+        // data.
+        memcpy(state->buffer + XXH3_BUFFER_SIZE - XXH3_STRIPE_LEN,
+               data - XXH3_STRIPE_LEN,
+               XXH3_STRIPE_LEN
+               );
+    }
+
+    memcpy(state->buffer, data, end - data);
+    state->bufferedSize = end - data;
+    memcpy(state->acc, acc.lanes(), sizeof(state->acc));
+}
+
+void xxh128_digest(XXH3State *state, char *digest) {
+    Hash128 h;
+    if (state->total > XXH3_MIDSIZE_MAX) {
+        XXH3Acc acc;
+        memcpy(acc.lanes(), state->acc, sizeof(state->acc));
+
+        uint8_t lastStripe[XXH3_STRIPE_LEN];
+        const uint8_t *last;
+        if (state->bufferedSize >= XXH3_STRIPE_LEN) {
+            unsigned int stripesSoFar = state->stripesSoFar;
+            xxh3ConsumeStripes(acc, stripesSoFar, state->buffer,
+                               (state->bufferedSize - 1) / XXH3_STRIPE_LEN,
+                               state->secret
+                               );
+            last = state->buffer + state->bufferedSize - XXH3_STRIPE_LEN;
+        } else {
+            // complete the stripe with the end of the previous buffer.
+            size_t catchup = XXH3_STRIPE_LEN - state->bufferedSize;
+            memcpy(lastStripe,
+                   state->buffer + XXH3_BUFFER_SIZE - catchup,
+                   catchup
+                   );
+            memcpy(lastStripe + catchup, state->buffer, state->bufferedSize);
+            last = lastStripe;
+        }
+        xxh3Accumulate512(acc, last,
+                          state->secret + XXH3_SECRET_LIMIT -
+                           XXH3_SECRET_LASTACC_START
+                          );
+
+        h.low = xxh3MergeAccs(acc.lanes(),
+                              state->secret + XXH3_SECRET_MERGEACCS_START,
+                              state->total * PRIME64_1
+                              );
+        h.high = xxh3MergeAccs(acc.lanes(),
+                               state->secret + XXH3_SECRET_SIZE - 64 -
+                                XXH3_SECRET_MERGEACCS_START,
+                               ~(state->total * PRIME64_2)
+                               );
+    } else {
+        h = xxh3Short128(state->buffer, state->total, xxh3Secret,
+                         state->seed
+                         );
+    }
+
+    writeBE64((uint8_t *)digest, h.high);
+    writeBE64((uint8_t *)digest + 8, h.low);
+}
+
+uint32_t crc32c(uint32_t crc, const char *buf, unsigned int size) {
+    static CRC32CFunc func = selectCRC32C();
+    return ~func(~crc, (const uint8_t *)buf, size);
+}
+
+SHAState *sha1_init() {
+    static const uint32_t init[5] = {
+        0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+    };
+    return newSHAState(init, 5);
+}
+
+void sha1_update(SHAState *state, const char *buf, unsigned int size) {
+    static SHABlocksFunc blocks = selectSHA1();
+    shaUpdate(state, blocks, (const uint8_t *)buf, size);
+}
+
+void sha1_digest(SHAState *state, char *digest) {
+    static SHABlocksFunc blocks = selectSHA1();
+    shaDigest(state, blocks, (uint8_t *)digest, 5);
+}
+
+SHAState *sha256_init() {
+    static const uint32_t init[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    return newSHAState(init, 8);
+}
+
+void sha256_update(SHAState *state, const char *buf, unsigned int size) {
+    static SHABlocksFunc blocks = selectSHA256();
+    shaUpdate(state, blocks, (const uint8_t *)buf, size);
+}
+
+void sha256_digest(SHAState *state, char *digest) {
+    static SHABlocksFunc blocks = selectSHA256();
+    shaDigest(state, blocks, (uint8_t *)digest, 8);
+}
+
+}} // namespace crack::runtime
+
+#include "ext/Module.h"
+#include "ext/Type.h"
+#include "ext/Func.h"
+
+extern "C"
+void crack_runtime_hash_rinit() {
+    return;
+}
+
+extern "C"
+void crack_runtime_hash_cinit(crack::ext::Module *mod) {
+    using namespace crack::runtime;
+    crack::ext::Func *f;
+    crack::ext::Type *type_void = mod->getVoidType();
+    crack::ext::Type *type_byteptr = mod->getByteptrType();
+    crack::ext::Type *type_uint32 = mod->getUint32Type();
+    crack::ext::Type *type_uint64 = mod->getUint64Type();
+    crack::ext::Type *type_uint = mod->getUintType();
+
+    crack::ext::Type *type_xxh64 = mod->addType("xxh64", sizeof(XXH64State));
+    type_xxh64->finish();
+
+    f = mod->addFunc(type_xxh64, "xxh64_init", (void *)xxh64_init);
+       f->addArg(type_uint64, "seed");
+
+    f = mod->addFunc(type_void, "xxh64_update", (void *)xxh64_update);
+       f->addArg(type_xxh64, "state");
+       f->addArg(type_byteptr, "data");
+       f->addArg(type_uint, "size");
+
+    f = mod->addFunc(type_uint64, "xxh64_digest", (void *)xxh64_digest);
+       f->addArg(type_xxh64, "state");
+
+    crack::ext::Type *type_xxh128 =
+        mod->addType("xxh128", sizeof(XXH3State));
+    type_xxh128->finish();
+
+    f = mod->addFunc(type_xxh128, "xxh128_init", (void *)xxh128_init);
+       f->addArg(type_uint64, "seed");
+
+    f = mod->addFunc(type_void, "xxh128_update", (void *)xxh128_update);
+       f->addArg(type_xxh128, "state");
+       f->addArg(type_byteptr, "data");
+       f->addArg(type_uint, "size");
+
+    f = mod->addFunc(type_void, "xxh128_digest", (void *)xxh128_digest);
+       f->addArg(type_xxh128, "state");
+       f->addArg(type_byteptr, "digest");
+
+    f = mod->addFunc(type_uint32, "crc32c", (void *)crc32c);
+       f->addArg(type_uint32, "crc");
+       f->addArg(type_byteptr, "data");
+       f->addArg(type_uint, "size");
+
+    crack::ext::Type *type_sha1 = mod->addType("sha1", sizeof(SHAState));
+    type_sha1->finish();
+
+    f = mod->addFunc(type_sha1, "sha1_init", (void *)sha1_init);
+
+    f = mod->addFunc(type_void, "sha1_update", (void *)sha1_update);
+       f->addArg(type_sha1, "state");
+       f->addArg(type_byteptr, "data");
+       f->addArg(type_uint, "size");
+
+    f = mod->addFunc(type_void, "sha1_digest", (void *)sha1_digest);
+       f->addArg(type_sha1, "state");
+       f->addArg(type_byteptr, "digest");
+
+    crack::ext::Type *type_sha256 =
+        mod->addType("sha256", sizeof(SHAState));
+    type_sha256->finish();
+
+    f = mod->addFunc(type_sha256, "sha256_init", (void *)sha256_init);
+
+    f = mod->addFunc(type_void, "sha256_update", (void *)sha256_update);
+       f->addArg(type_sha256, "state");
+       f->addArg(type_byteptr, "data");
+       f->addArg(type_uint, "size");
+
+    f = mod->addFunc(type_void, "sha256_digest", (void *)sha256_digest);
+       f->addArg(type_sha256, "state");
+       f->addArg(type_byteptr, "digest");
+}
@@ -22,6 +22,10 @@
 #include <signal.h>
 #include <errno.h>
 #include <unistd.h>
+#include "config.h"
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
 
 #include "debug/DebugTools.h"
 #include "ext/Func.h"
@@ -31,8 +35,11 @@
 #include "Util.h"
 #include "Net.h"
 #include "Math.h"
+#include "MMap.h"
 #include "Exceptions.h"
+#include "Float.h"
 #include "Process.h"
+#include "Alloc.h"
 using namespace crack::ext;
 using namespace crack::runtime;
 
@@ -40,6 +47,7 @@ extern "C" bool __CrackUncaughtException();
 extern "C" void crack_runtime_time_cinit(crack::ext::Module *mod);
 extern "C" void crack_runtime_md5_cinit(crack::ext::Module *mod);
 extern "C" void crack_runtime_xdr_cinit(crack::ext::Module *mod);
+extern "C" void crack_runtime_hash_cinit(crack::ext::Module *mod);
 
 
 // stat() appears to have some funny linkage issues in native mode so we wrap 
@@ -48,6 +56,13 @@ extern "C" int crack_runtime_stat(const char *path, struct stat *buf) {
     return stat(path, buf);
 }
 
+extern "C" int crack_runtime_fstatat(int dirfd, const char *path,
+                                     struct stat *buf,
+                                     int flags
+                                     ) {
+    return fstatat(dirfd, path, buf, flags);
+}
+
 extern "C"
 void crack_runtime_rinit(void) {
     return;
@@ -64,6 +79,7 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     Type *int16Type = mod->getInt16Type();
     Type *int32Type = mod->getInt32Type();
     Type *int64Type = mod->getInt64Type();
+    Type *uint64Type = mod->getUint64Type();
     Type *uintType = mod->getUintType();
     Type *byteType = mod->getByteType();
     Type *voidType = mod->getVoidType();
@@ -111,6 +127,78 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     f = mod->addFunc(intType, "readdir", (void *)crack::runtime::readdir);
     f->addArg(cdType, "d");
     
+    mod->addConstant(intType, "DTYPE_DIR", CRACK_DTYPE_DIR);
+    mod->addConstant(intType, "DTYPE_FILE", CRACK_DTYPE_FILE);
+    mod->addConstant(intType, "DTYPE_OTHER", CRACK_DTYPE_OTHER);
+    mod->addConstant(intType, "DTYPE_LINK", CRACK_DTYPE_LINK);
+
+    Type *dirStreamType = 
+        mod->addType("DirStream", sizeof(crack::runtime::DirStream));
+    dirStreamType->addMethod(boolType, "oper to .builtin.bool",
+                             (void *)crack::runtime::DirStream_toBool
+                             );
+    dirStreamType->finish();
+
+    f = mod->addFunc(dirStreamType, "openDirStream",
+                     (void *)crack::runtime::openDirStream
+                     );
+    f->addArg(byteptrType, "name");
+
+    f = mod->addFunc(dirStreamType, "openDirStreamAt",
+                     (void *)crack::runtime::openDirStreamAt
+                     );
+    f->addArg(intType, "dirfd");
+    f->addArg(byteptrType, "name");
+
+    f = mod->addFunc(intType, "readDirStream",
+                     (void *)crack::runtime::readDirStream
+                     );
+    f->addArg(dirStreamType, "d");
+
+    f = mod->addFunc(cdentType, "getDirStreamEntry",
+                     (void *)crack::runtime::getDirStreamEntry
+                     );
+    f->addArg(dirStreamType, "d");
+
+    f = mod->addFunc(intType, "getDirStreamFD",
+                     (void *)crack::runtime::getDirStreamFD
+                     );
+    f->addArg(dirStreamType, "d");
+
+    f = mod->addFunc(intType, "closeDirStream",
+                     (void *)crack::runtime::closeDirStream
+                     );
+    f->addArg(dirStreamType, "d");
+
+    // TreeWalker is opaque and never allocated from crack (the class is only
+    // defined in Dir.cc), so its instance size is irrelevant.
+    Type *treeWalkerType = mod->addType("TreeWalker", sizeof(void *));
+    treeWalkerType->addMethod(boolType, "oper to .builtin.bool",
+                              (void *)crack::runtime::TreeWalker_toBool
+                              );
+    treeWalkerType->finish();
+
+    f = mod->addFunc(treeWalkerType, "openTreeWalker",
+                     (void *)crack::runtime::openTreeWalker
+                     );
+    f->addArg(byteptrType, "root");
+    f->addArg(intType, "threads");
+
+    f = mod->addFunc(intType, "readTreeWalker",
+                     (void *)crack::runtime::readTreeWalker
+                     );
+    f->addArg(treeWalkerType, "walker");
+
+    f = mod->addFunc(cdentType, "getTreeWalkerEntry",
+                     (void *)crack::runtime::getTreeWalkerEntry
+                     );
+    f->addArg(treeWalkerType, "walker");
+
+    f = mod->addFunc(intType, "closeTreeWalker",
+                     (void *)crack::runtime::closeTreeWalker
+                     );
+    f->addArg(treeWalkerType, "walker");
+
     f = mod->addFunc(intType, "fnmatch", (void *)crack::runtime::fnmatch);
     f->addArg(byteptrType, "pattern");
     f->addArg(byteptrType, "string");
@@ -189,6 +277,17 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     f->addArg(byteptrType, "path");
     f->addArg(statType, "buf");
 
+    f = mod->addFunc(intType, "fstatat", (void *)crack_runtime_fstatat,
+                     "crack_runtime_fstatat"
+                     );
+    f->addArg(intType, "dirfd");
+    f->addArg(byteptrType, "path");
+    f->addArg(statType, "buf");
+    f->addArg(intType, "flags");
+
+    mod->addConstant(intType, "AT_FDCWD", AT_FDCWD);
+    mod->addConstant(intType, "AT_SYMLINK_NOFOLLOW", AT_SYMLINK_NOFOLLOW);
+
     f = mod->addFunc(intType, "fileRemove", (void *)remove);
     f->addArg(byteptrType, "path");
 
@@ -219,6 +318,85 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     f->addArg(byteptrType, "buf");
     f->addArg(mod->getUintType(), "size");
 
+    f = mod->addFunc(mod->getIntType(), "float32_str", 
+                     (void *)crack::runtime::float32_str
+                     );
+    f->addArg(mod->getFloat32Type(), "val");
+    f->addArg(byteptrType, "buf");
+    f->addArg(mod->getUintType(), "size");
+
+    f = mod->addFunc(intType, "findByte",
+                     (void *)crack::runtime::findByte
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(byteType, "c");
+    f->addArg(uintType, "size");
+
+    f = mod->addFunc(intType, "rfindByte",
+                     (void *)crack::runtime::rfindByte
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(byteType, "c");
+    f->addArg(uintType, "size");
+
+    f = mod->addFunc(intType, "findBytes",
+                     (void *)crack::runtime::findBytes
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(uintType, "size");
+    f->addArg(byteptrType, "sub");
+    f->addArg(uintType, "subSize");
+
+    f = mod->addFunc(intType, "rfindBytes",
+                     (void *)crack::runtime::rfindBytes
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(uintType, "size");
+    f->addArg(byteptrType, "sub");
+    f->addArg(uintType, "subSize");
+
+    f = mod->addFunc(intType, "findByteInSet",
+                     (void *)crack::runtime::findByteInSet
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(uintType, "size");
+    f->addArg(byteptrType, "set");
+    f->addArg(uintType, "setSize");
+
+    f = mod->addFunc(intType, "findByteNotInSet",
+                     (void *)crack::runtime::findByteNotInSet
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(uintType, "size");
+    f->addArg(byteptrType, "set");
+    f->addArg(uintType, "setSize");
+
+    f = mod->addFunc(intType, "findJsonStringDelim",
+                     (void *)crack::runtime::findJsonStringDelim
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(uintType, "size");
+
+    f = mod->addFunc(uintType, "skipJsonWhitespace",
+                     (void *)crack::runtime::skipJsonWhitespace
+                     );
+    f->addArg(byteptrType, "buf");
+    f->addArg(uintType, "size");
+
+    f = mod->addFunc(voidType, "xdrCopy32",
+                     (void *)crack::runtime::xdrCopy32
+                     );
+    f->addArg(voidptrType, "dst");
+    f->addArg(voidptrType, "src");
+    f->addArg(uintType, "count");
+
+    f = mod->addFunc(voidType, "xdrCopy64",
+                     (void *)crack::runtime::xdrCopy64
+                     );
+    f->addArg(voidptrType, "dst");
+    f->addArg(voidptrType, "src");
+    f->addArg(uintType, "count");
+
     f = mod->addFunc(uintType, "rand", 
                      (void *)crack::runtime::rand
                      );
@@ -365,10 +543,21 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     mod->addConstant(intType, "POLLERR", POLLERR);
     mod->addConstant(intType, "POLLHUP", POLLHUP);
     mod->addConstant(intType, "POLLNVAL", POLLNVAL);
+#ifdef HAVE_SYS_EPOLL_H
+    mod->addConstant(intType, "EPOLLET", static_cast<int>(EPOLLET));
+#else
+    mod->addConstant(intType, "EPOLLET", 0);
+#endif
     mod->addConstant(uint32Type, "INADDR_ANY", static_cast<int>(INADDR_ANY));
 
     mod->addConstant(intType, "EAGAIN", EAGAIN);
     mod->addConstant(intType, "EWOULDBLOCK", EWOULDBLOCK);
+    mod->addConstant(intType, "EINTR", EINTR);
+#ifdef __linux__
+    mod->addConstant(intType, "MSG_NOSIGNAL", MSG_NOSIGNAL);
+#else
+    mod->addConstant(intType, "MSG_NOSIGNAL", 0);
+#endif
     
     f = mod->addFunc(uint32Type, "makeIPV4", 
                      (void*)crack::runtime::makeIPV4);
@@ -647,6 +836,115 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     pollSetType->finish();
     // end PollSet
 
+    // begin EPollSet
+    Type *epollSetType = mod->addType("EPollSet", 0);
+    f = epollSetType->addStaticMethod(epollSetType, "oper new",
+                                      (void *)&crack::runtime::EPollSet_create
+                                      );
+    f->addArg(uintType, "batchSize");
+
+    f = epollSetType->addMethod(voidType, "destroy",
+                                (void *)crack::runtime::EPollSet_destroy
+                                );
+
+    f = epollSetType->addMethod(intType, "add",
+                                (void *)crack::runtime::EPollSet_add
+                                );
+    f->addArg(intType, "fd");
+    f->addArg(intType, "events");
+
+    f = epollSetType->addMethod(intType, "modify",
+                                (void *)crack::runtime::EPollSet_modify
+                                );
+    f->addArg(intType, "fd");
+    f->addArg(intType, "events");
+
+    f = epollSetType->addMethod(intType, "remove",
+                                (void *)crack::runtime::EPollSet_remove
+                                );
+    f->addArg(intType, "fd");
+
+    f = epollSetType->addMethod(intType, "wait",
+                                (void *)crack::runtime::EPollSet_wait
+                                );
+    f->addArg(timeValType, "tv");
+    f->addArg(sigSetType, "sigmask");
+
+    f = epollSetType->addMethod(intType, "next",
+                                (void *)crack::runtime::EPollSet_next
+                                );
+    f->addArg(pollEventType, "outputEntry");
+
+    epollSetType->finish();
+    // end EPollSet
+
+    // timerfd
+    f = mod->addFunc(intType, "timerfd_create",
+                     (void *)crack::runtime::TimerFD_create
+                     );
+
+    f = mod->addFunc(intType, "timerfd_set",
+                     (void *)crack::runtime::TimerFD_set
+                     );
+    f->addArg(intType, "fd");
+    f->addArg(int32Type, "secs");
+    f->addArg(int32Type, "nsecs");
+    f->addArg(int32Type, "intervalSecs");
+    f->addArg(int32Type, "intervalNsecs");
+
+    f = mod->addFunc(int64Type, "timerfd_read",
+                     (void *)crack::runtime::TimerFD_read
+                     );
+    f->addArg(intType, "fd");
+
+    // begin IOVecs
+    Type *ioVecsType = mod->addType("IOVecs", 0);
+    f = ioVecsType->addStaticMethod(ioVecsType, "oper new",
+                                    (void *)&crack::runtime::IOVecs_create
+                                    );
+    f->addArg(uintType, "size");
+
+    f = ioVecsType->addMethod(voidType, "destroy",
+                              (void *)crack::runtime::IOVecs_destroy
+                              );
+
+    f = ioVecsType->addMethod(voidType, "set",
+                              (void *)crack::runtime::IOVecs_set
+                              );
+    f->addArg(uintType, "index");
+    f->addArg(byteptrType, "base");
+    f->addArg(uintzType, "len");
+
+    f = ioVecsType->addMethod(int64Type, "writev",
+                              (void *)crack::runtime::IOVecs_writev
+                              );
+    f->addArg(intType, "fd");
+    f->addArg(uintType, "count");
+
+    f = ioVecsType->addMethod(int64Type, "readv",
+                              (void *)crack::runtime::IOVecs_readv
+                              );
+    f->addArg(intType, "fd");
+    f->addArg(uintType, "count");
+
+    f = ioVecsType->addMethod(int64Type, "sendmsg",
+                              (void *)crack::runtime::IOVecs_sendmsg
+                              );
+    f->addArg(intType, "fd");
+    f->addArg(uintType, "count");
+    f->addArg(intType, "flags");
+
+    ioVecsType->finish();
+    // end IOVecs
+
+    f = mod->addFunc(int64Type, "sendfile",
+                     (void *)crack::runtime::crk_sendfile
+                     );
+    f->addArg(intType, "outFd");
+    f->addArg(intType, "inFd");
+    f->addArg(int64Type, "offset");
+    f->addArg(uint64Type, "count");
+
     // addrinfo
     Type *addrinfoType = mod->addType("AddrInfo", sizeof(addrinfo));
     f = addrinfoType->addStaticMethod(addrinfoType, "oper new", 
@@ -721,6 +1019,16 @@ extern "C" void crack_runtime_cinit(Module *mod) {
 
     f = mod->addFunc(voidType, "free", (void *)free, "free");
     f->addArg(voidptrType, "size");
+
+    f = mod->addFunc(byteptrType, "allocObject", (void *)__CrackAllocObject,
+                     "__CrackAllocObject"
+                     );
+    f->addArg(uintType, "size");
+
+    f = mod->addFunc(voidType, "freeObject", (void *)__CrackFreeObject,
+                     "__CrackFreeObject"
+                     );
+    f->addArg(voidptrType, "obj");
     
     f = mod->addFunc(voidType, "strcpy", (void *)strcpy, "strcpy");
     f->addArg(byteptrType, "dst");
@@ -799,7 +1107,7 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     f->addArg(uintzType, "offset");
 
     // munmap
-    f = mod->addFunc(intType, "munmap", (void *)mmap, "munmap");
+    f = mod->addFunc(intType, "munmap", (void *)munmap, "munmap");
     f->addArg(voidptrType, "start");
     f->addArg(uintzType, "length"); 
 
@@ -815,6 +1123,47 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     mod->addConstant(intType, "MAP_SHARED", MAP_SHARED);
     mod->addConstant(intType, "MAP_PRIVATE", MAP_PRIVATE);
 
+    // madvise advice
+    mod->addConstant(intType, "MADV_NORMAL", MADV_NORMAL);
+    mod->addConstant(intType, "MADV_RANDOM", MADV_RANDOM);
+    mod->addConstant(intType, "MADV_SEQUENTIAL", MADV_SEQUENTIAL);
+    mod->addConstant(intType, "MADV_WILLNEED", MADV_WILLNEED);
+    mod->addConstant(intType, "MADV_DONTNEED", MADV_DONTNEED);
+
+    // begin MappedFile
+    Type *mappedFileType = mod->addType("MappedFile", 
+                                        sizeof(crack::runtime::MappedFile)
+                                        );
+    mappedFileType->addInstVar(byteptrType, "data",
+                               CRACK_OFFSET(crack::runtime::MappedFile, data)
+                               );
+    mappedFileType->addInstVar(uint64Type, "size",
+                               CRACK_OFFSET(crack::runtime::MappedFile, size)
+                               );
+    mappedFileType->addInstVar(intType, "fd",
+                               CRACK_OFFSET(crack::runtime::MappedFile, fd)
+                               );
+    f = mappedFileType->addStaticMethod(
+        mappedFileType, 
+        "oper new",
+        (void *)crack::runtime::MappedFile_open
+    );
+    f->addArg(byteptrType, "path");
+    f->addArg(boolType, "writable");
+
+    f = mappedFileType->addMethod(voidType, "close",
+                                  (void *)crack::runtime::MappedFile_close
+                                  );
+
+    f = mappedFileType->addMethod(intType, "advise",
+                                  (void *)crack::runtime::MappedFile_advise
+                                  );
+    f->addArg(uint64Type, "offset");
+    f->addArg(uint64Type, "length");
+    f->addArg(intType, "advice");
+    mappedFileType->finish();
+    // end MappedFile
+
     // Add math functions
     crack::runtime::math_init(mod);
     
@@ -826,6 +1175,9 @@ extern "C" void crack_runtime_cinit(Module *mod) {
 
     // Add xdr functions
     crack_runtime_xdr_cinit(mod);
+
+    // Add xxHash, CRC32C and SHA functions
+    crack_runtime_hash_cinit(mod);
     
     // add exception functions
     mod->addConstant(intType, "EXCEPTION_MATCH_FUNC", 
@@ -928,6 +1280,10 @@ extern "C" void crack_runtime_cinit(Module *mod) {
     f->addArg(intType, "pid");
     f->addArg(intType, "noHang");
 
+    f = mod->addFunc(int64Type, "getProcessMaxRSS",
+                     (void *)&crack::runtime::getProcessMaxRSS);
+    f->addArg(intType, "pid");
+
     f = mod->addFunc(voidType, "signalProcess",
                      (void *)&crack::runtime::signalProcess);
     f->addArg(intType, "pid");
@@ -949,6 +1305,10 @@ extern "C" void crack_runtime_cinit(Module *mod) {
                      );
     f->addArg(voidptrType, "address");
     f->addArg(byteptrArrayType, "info");
+    f = mod->addFunc(voidptrType, "getFuncStart",
+                     (void *)&crack::debug::getFuncStart
+                     );
+    f->addArg(voidptrType, "address");
     f = mod->addFunc(voidType, "registerFuncTable",
                      (void *)&crack::debug::registerFuncTable
                      );
@@ -0,0 +1,82 @@
+// Runtime support for memory mapped files
+// Copyright 2012 Google Inc.
+// 
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// 
+
+#include "MMap.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace crack { namespace runtime {
+
+MappedFile *MappedFile_open(const char *path, bool writable) {
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd == -1)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st)) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return 0;
+    }
+
+    void *data = 0;
+    if (st.st_size) {
+        data = mmap(0, st.st_size, 
+                    writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                    MAP_SHARED, 
+                    fd, 
+                    0
+                    );
+        if (data == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            errno = err;
+            return 0;
+        }
+    }
+
+    MappedFile *file = new MappedFile;
+    file->data = (char *)data;
+    file->size = st.st_size;
+    file->fd = fd;
+    return file;
+}
+
+void MappedFile_close(MappedFile *file) {
+    if (file->data)
+        munmap(file->data, file->size);
+    close(file->fd);
+    delete file;
+}
+
+int MappedFile_advise(MappedFile *file, uint64_t offset, uint64_t length,
+                      int advice
+                      ) {
+    if (!file->data)
+        return 0;
+    if (offset > file->size) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (length > file->size - offset)
+        length = file->size - offset;
+
+    // madvise() requires a page aligned address.
+    uint64_t pageSize = sysconf(_SC_PAGESIZE);
+    uint64_t start = offset & ~(pageSize - 1);
+    return madvise(file->data + start, length + (offset - start), advice);
+}
+
+}} // namespace crack::runtime
@@ -0,0 +1,39 @@
+// Runtime support for memory mapped files
+// Copyright 2012 Google Inc.
+// 
+//   This Source Code Form is subject to the terms of the Mozilla Public
+//   License, v. 2.0. If a copy of the MPL was not distributed with this
+//   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+// 
+
+#ifndef _runtime_MMap_h_
+#define _runtime_MMap_h_
+
+#include <stdint.h>
+
+namespace crack { namespace runtime {
+
+// mirrored in crack
+struct MappedFile {
+    char *data;
+    uint64_t size;
+    int fd;
+};
+
+// Maps the entire file into memory, read-only unless 'writable' is true 
+// (in which case changes are written back to the file).  Returns null and 
+// sets errno on failure.  Empty files are "mapped" with a null data pointer.
+MappedFile *MappedFile_open(const char *path, bool writable);
+
+// Unmaps the file and frees the structure.
+void MappedFile_close(MappedFile *file);
+
+// madvise() on a range of the mapping.  The range is expanded to page 
+// boundaries.
+int MappedFile_advise(MappedFile *file, uint64_t offset, uint64_t length,
+                      int advice
+                      );
+
+}} // namespace crack::runtime
+
+#endif // _runtime_MMap_h_
@@ -19,6 +19,7 @@
 #include <dlfcn.h>
 #include "ext/Module.h"
 #include "ext/Func.h"
+#include "Float.h"
 
 using namespace crack::ext;
 using namespace std;
@@ -256,12 +257,16 @@ int crk_strtoi(char *s){
 
 float crk_strtof(char *s){
    errno = 0;
-   return (float)strtof(s, (char**)NULL);
+   return fast_strtof(s, (char**)NULL);
 }
 
-float crk_strtod(char *s){
+double crk_strtod(char *s){
    errno = 0;
-   return (double)strtod(s, (char**)NULL);
+   return fast_strtod(s, (char**)NULL);
+}
+
+float crk_atof(char *s){
+   return fast_strtof(s, (char**)NULL);
 }
 
 
@@ -415,7 +420,7 @@ void math_init(Module *mod) {
   strtof_func->addArg(mod->getByteptrType(), "str");
 
   // atof like strtof, but no error checking
-  Func *atof_func = mod->addFunc(mod->getFloatType(), "atof", (void *)atof);
+  Func *atof_func = mod->addFunc(mod->getFloatType(), "atof", (void *)crk_atof);
   atof_func->addArg(mod->getByteptrType(), "str");
 
   // strtod
@@ -755,12 +760,16 @@ int crk_strtoi(char *s){
 
 float crk_strtof(char *s){
    errno = 0;
-   return (float)strtof(s, (char**)NULL);
+   return fast_strtof(s, (char**)NULL);
 }
 
-float crk_strtod(char *s){
+double crk_strtod(char *s){
    errno = 0;
-   return (double)strtod(s, (char**)NULL);
+   return fast_strtod(s, (char**)NULL);
+}
+
+float crk_atof(char *s){
+   return fast_strtof(s, (char**)NULL);
 }
 
 
@@ -902,7 +911,7 @@ void math_init(Module *mod) {
   strtof_func->addArg(mod->getByteptrType(), "str");
 
   // atof like strtof, but no error checking
-  Func *atof_func = mod->addFunc(mod->getFloatType(), "atof", (void *)atof);
+  Func *atof_func = mod->addFunc(mod->getFloatType(), "atof", (void *)crk_atof);
   atof_func->addArg(mod->getByteptrType(), "str");
 
   // strtod
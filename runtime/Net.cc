@@ -32,8 +32,19 @@
 #include <unistd.h>
 #endif
 #include <fcntl.h>
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+#ifdef HAVE_SYS_TIMERFD_H
+#include <sys/timerfd.h>
+#endif
+#ifdef HAVE_SYS_SENDFILE_H
+#include <sys/sendfile.h>
+#endif
+#include <sys/uio.h>
 
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -212,8 +223,8 @@ void PollSet_get(struct pollfd *set, unsigned int index,
                  ) {
     struct pollfd &elem = set[index];
     outputEntry->fd = elem.fd;
-    outputEntry->events = elem.fd;
-    outputEntry->revents = elem.fd;
+    outputEntry->events = elem.events;
+    outputEntry->revents = elem.revents;
 }
 
 // find the next poll entry that has an event in revents whose index is >= 
@@ -258,6 +269,313 @@ int PollSet_poll(struct pollfd *fds, unsigned int nfds, TimeVal *tv,
 #endif
 }
 
+#ifdef HAVE_SYS_EPOLL_H
+
+struct EPollSet {
+    int epfd;
+
+    // events returned by the last wait, the number of them and the index of 
+    // the next one to be returned by EPollSet_next().
+    epoll_event *events;
+    int batchSize, count, index;
+
+    // file descriptors that epoll won't manage (regular files and 
+    // directories).  poll() reports these as always ready, so we do the same.
+    std::vector<PollEvt> alwaysReady;
+};
+
+namespace {
+    // the POLL* constants and the EPOLL* constants have the same values on 
+    // linux, but the kernel defines them separately so translate 
+    // explicitly.
+    uint32_t toEPollEvents(int events) {
+        uint32_t result = 0;
+        if (events & POLLIN) result |= EPOLLIN;
+        if (events & POLLOUT) result |= EPOLLOUT;
+        if (events & POLLPRI) result |= EPOLLPRI;
+        if (events & POLLERR) result |= EPOLLERR;
+        if (events & POLLHUP) result |= EPOLLHUP;
+        if (events & EPOLLET) result |= EPOLLET;
+        return result;
+    }
+
+    int fromEPollEvents(uint32_t events) {
+        int result = 0;
+        if (events & EPOLLIN) result |= POLLIN;
+        if (events & EPOLLOUT) result |= POLLOUT;
+        if (events & EPOLLPRI) result |= POLLPRI;
+        if (events & EPOLLERR) result |= POLLERR;
+        if (events & EPOLLHUP) result |= POLLHUP;
+        return result;
+    }
+
+    int findAlwaysReady(EPollSet *set, int fd) {
+        for (size_t i = 0; i < set->alwaysReady.size(); ++i)
+            if (set->alwaysReady[i].fd == fd)
+                return i;
+        return -1;
+    }
+
+    int epollCtl(EPollSet *set, int op, int fd, int events) {
+        epoll_event evt;
+        evt.events = toEPollEvents(events);
+        evt.data.u64 = 0;
+        evt.data.fd = fd;
+        return epoll_ctl(set->epfd, op, fd, &evt);
+    }
+}
+
+EPollSet *EPollSet_create(unsigned int batchSize) {
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd == -1)
+        return 0;
+
+    EPollSet *set = new EPollSet();
+    set->epfd = epfd;
+    set->batchSize = batchSize ? batchSize : 1;
+    set->events = new epoll_event[set->batchSize];
+    set->count = set->index = 0;
+    return set;
+}
+
+void EPollSet_destroy(EPollSet *set) {
+    close(set->epfd);
+    delete [] set->events;
+    delete set;
+}
+
+int EPollSet_add(EPollSet *set, int fd, int events) {
+    int rc = epollCtl(set, EPOLL_CTL_ADD, fd, events);
+    if (rc == -1 && errno == EPERM) {
+        PollEvt evt = {fd, events, 0};
+        set->alwaysReady.push_back(evt);
+        return 0;
+    }
+    return rc;
+}
+
+int EPollSet_modify(EPollSet *set, int fd, int events) {
+    int i = findAlwaysReady(set, fd);
+    if (i != -1) {
+        set->alwaysReady[i].events = events;
+        return 0;
+    }
+    return epollCtl(set, EPOLL_CTL_MOD, fd, events);
+}
+
+int EPollSet_remove(EPollSet *set, int fd) {
+    int i = findAlwaysReady(set, fd);
+    if (i != -1) {
+        set->alwaysReady.erase(set->alwaysReady.begin() + i);
+        return 0;
+    }
+
+    // the kernel drops closed descriptors on its own, so EBADF here just 
+    // means that the caller closed the file before removing it.
+    epoll_event evt;
+    int rc = epoll_ctl(set->epfd, EPOLL_CTL_DEL, fd, &evt);
+    return (rc == -1 && errno == EBADF) ? 0 : rc;
+}
+
+int EPollSet_wait(EPollSet *set, TimeVal *tv, sigset_t *sigmask) {
+    set->count = set->index = 0;
+
+    // convert the timeout to milliseconds, rounding up so that we never 
+    // return before the timeout has elapsed.  If we have descriptors that 
+    // are always ready, we just want to check for events.
+    int timeout = -1;
+    if (set->alwaysReady.size())
+        timeout = 0;
+    else if (tv)
+        timeout = tv->secs * 1000 + (tv->nsecs + 999999) / 1000000;
+
+    int rc = epoll_pwait(set->epfd, set->events, set->batchSize, timeout,
+                         sigmask
+                         );
+    if (rc == -1)
+        return -1;
+
+    set->count = rc;
+    for (size_t i = 0; i < set->alwaysReady.size(); ++i) {
+        PollEvt &evt = set->alwaysReady[i];
+        evt.revents = evt.events & (POLLIN | POLLOUT);
+        if (evt.revents)
+            ++rc;
+    }
+    return rc;
+}
+
+// Stores the next event from the last wait in outputEntry and returns its 
+// file descriptor.  Returns -1 when there are no more events.
+int EPollSet_next(EPollSet *set, PollEvt *outputEntry) {
+    if (set->index < set->count) {
+        epoll_event &evt = set->events[set->index++];
+        outputEntry->fd = evt.data.fd;
+        outputEntry->events = 0;
+        outputEntry->revents = fromEPollEvents(evt.events);
+        return outputEntry->fd;
+    }
+
+    // events for the descriptors that epoll wouldn't manage.
+    // index is at least count here.
+    while (size_t(set->index - set->count) < set->alwaysReady.size()) {
+        PollEvt &evt = set->alwaysReady[set->index++ - set->count];
+        if (evt.revents) {
+            *outputEntry = evt;
+            return evt.fd;
+        }
+    }
+
+    return -1;
+}
+
+#else
+
+EPollSet *EPollSet_create(unsigned int batchSize) { return 0; }
+void EPollSet_destroy(EPollSet *set) {}
+int EPollSet_add(EPollSet *set, int fd, int events) { return -1; }
+int EPollSet_modify(EPollSet *set, int fd, int events) { return -1; }
+int EPollSet_remove(EPollSet *set, int fd) { return -1; }
+int EPollSet_wait(EPollSet *set, TimeVal *tv, sigset_t *sigmask) {
+    return -1;
+}
+int EPollSet_next(EPollSet *set, PollEvt *outputEntry) { return -1; }
+
+#endif
+
+#ifdef HAVE_SYS_TIMERFD_H
+
+int TimerFD_create() {
+    return timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+}
+
+// Arms the timer to expire after secs/nsecs and then every 
+// intervalSecs/intervalNsecs.  A zero interval creates a one-shot timer, a 
+// zero initial value disarms the timer.
+int TimerFD_set(int fd, int32_t secs, int32_t nsecs, int32_t intervalSecs,
+                int32_t intervalNsecs
+                ) {
+    itimerspec spec;
+    spec.it_value.tv_sec = secs;
+    spec.it_value.tv_nsec = nsecs;
+    spec.it_interval.tv_sec = intervalSecs;
+    spec.it_interval.tv_nsec = intervalNsecs;
+    return timerfd_settime(fd, 0, &spec, 0);
+}
+
+// Returns the number of expirations since the last read, 0 if the timer 
+// hasn't expired, -1 on error.
+int64_t TimerFD_read(int fd) {
+    uint64_t expirations;
+    if (::read(fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+        return (errno == EAGAIN) ? 0 : -1;
+    return expirations;
+}
+
+#else
+
+int TimerFD_create() {
+    errno = ENOSYS;
+    return -1;
+}
+
+int TimerFD_set(int fd, int32_t secs, int32_t nsecs, int32_t intervalSecs,
+                int32_t intervalNsecs
+                ) {
+    errno = ENOSYS;
+    return -1;
+}
+
+int64_t TimerFD_read(int fd) {
+    errno = ENOSYS;
+    return -1;
+}
+
+#endif
+
+iovec *IOVecs_create(unsigned int size) {
+    return (iovec *)calloc(size, sizeof(iovec));
+}
+
+void IOVecs_destroy(iovec *vecs) {
+    free(vecs);
+}
+
+void IOVecs_set(iovec *vecs, unsigned int index, char *base, size_t len) {
+    vecs[index].iov_base = base;
+    vecs[index].iov_len = len;
+}
+
+int64_t IOVecs_writev(iovec *vecs, int fd, unsigned int count) {
+    return writev(fd, vecs, count);
+}
+
+int64_t IOVecs_readv(iovec *vecs, int fd, unsigned int count) {
+    return readv(fd, vecs, count);
+}
+
+int64_t IOVecs_sendmsg(iovec *vecs, int fd, unsigned int count, int flags) {
+    msghdr msg = {0};
+    msg.msg_iov = vecs;
+    msg.msg_iovlen = count;
+    return sendmsg(fd, &msg, flags);
+}
+
+namespace {
+#ifdef HAVE_SYS_SENDFILE_H
+
+    ssize_t doSendfile(int outFd, int inFd, int64_t offset, uint64_t count) {
+        off_t off = offset;
+        return sendfile(outFd, inFd, &off, count);
+    }
+
+#else
+
+    // Portable fallback, copies a block at a time through user space.
+    ssize_t doSendfile(int outFd, int inFd, int64_t offset, uint64_t count) {
+        char buf[65536];
+        ssize_t total = 0;
+        while (count) {
+            ssize_t amt = pread(inFd, buf, 
+                                count < sizeof(buf) ? count : sizeof(buf),
+                                offset
+                                );
+            if (amt <= 0)
+                return total ? total : amt;
+            ssize_t written = write(outFd, buf, amt);
+            if (written <= 0)
+                return total ? total : written;
+            total += written;
+            offset += written;
+            count -= written;
+            if (written < amt)
+                break;
+        }
+        return total;
+    }
+
+#endif
+}
+
+int64_t crk_sendfile(int outFd, int inFd, int64_t offset, uint64_t count) {
+    // there's no MSG_NOSIGNAL equivalent for sendfile(), so block SIGPIPE 
+    // for the duration of the call and discard it if the call generated one.
+    sigset_t pipeSet, oldSet;
+    sigemptyset(&pipeSet);
+    sigaddset(&pipeSet, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSet, &oldSet);
+
+    ssize_t result = doSendfile(outFd, inFd, offset, count);
+
+    if (result < 0 && errno == EPIPE) {
+        timespec zero = {0, 0};
+        while (sigtimedwait(&pipeSet, 0, &zero) == -1 && errno == EINTR) ;
+        errno = EPIPE;
+    }
+    pthread_sigmask(SIG_SETMASK, &oldSet, 0);
+    return result;
+}
+
 sigset_t *SigSet_create() {
     return (sigset_t *)malloc(sizeof(sigset_t));
 }
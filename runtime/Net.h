@@ -14,6 +14,7 @@
 #include <poll.h>
 #include <netdb.h>
 #include <sys/un.h>
+#include <sys/uio.h>
 #ifndef UNIX_PATH_MAX
 # define UNIX_PATH_MAX 108
 #endif
@@ -120,6 +121,44 @@ int PollSet_poll(struct pollfd *fds, unsigned int nfds, TimeVal *tv,
                  sigset_t *sigmask
                  );
 
+// An epoll based event set.  Unlike PollSet, file descriptors are registered
+// with the kernel so add/modify/remove are O(1) and a wait only returns the
+// descriptors that actually have events.  Event masks use the POLL*
+// constants, optionally or'ed with EPOLLET for edge triggering.
+// EPollSet_create() returns null on platforms without epoll.
+struct EPollSet;
+
+EPollSet *EPollSet_create(unsigned int batchSize);
+void EPollSet_destroy(EPollSet *set);
+int EPollSet_add(EPollSet *set, int fd, int events);
+int EPollSet_modify(EPollSet *set, int fd, int events);
+int EPollSet_remove(EPollSet *set, int fd);
+int EPollSet_wait(EPollSet *set, TimeVal *tv, sigset_t *sigmask);
+int EPollSet_next(EPollSet *set, PollEvt *outputEntry);
+
+// timerfd wrappers, these return -1 and set errno to ENOSYS on platforms
+// without timerfd.
+int TimerFD_create();
+int TimerFD_set(int fd, int32_t secs, int32_t nsecs, int32_t intervalSecs,
+                int32_t intervalNsecs
+                );
+int64_t TimerFD_read(int fd);
+
+// A fixed size array of iovec structures for gathered writes.
+iovec *IOVecs_create(unsigned int size);
+void IOVecs_destroy(iovec *vecs);
+void IOVecs_set(iovec *vecs, unsigned int index, char *base, size_t len);
+int64_t IOVecs_writev(iovec *vecs, int fd, unsigned int count);
+int64_t IOVecs_readv(iovec *vecs, int fd, unsigned int count);
+
+// Gathered send() on a socket, 'flags' are the send() flags.
+int64_t IOVecs_sendmsg(iovec *vecs, int fd, unsigned int count, int flags);
+
+// Copies 'count' bytes starting at 'offset' in 'inFd' to 'outFd', in the 
+// kernel where possible.  Returns the number of bytes written, which may be 
+// less than 'count' on a non-blocking descriptor, or -1 on error.  Writing 
+// to a closed socket fails with EPIPE rather than raising SIGPIPE.
+int64_t crk_sendfile(int outFd, int inFd, int64_t offset, uint64_t count);
 
 addrinfo *AddrInfo_create(const char *host, const char *service,
                           addrinfo *hints
@@ -18,15 +18,43 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include <fcntl.h>
 #include <signal.h>
+#include <spawn.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 using namespace crack::ext;
 
+extern char **environ;
+
 namespace crack { namespace runtime {
 
+namespace {
+    // the peak resident set sizes of the most recently reaped children.
+    const int rssHistorySize = 16;
+    struct ChildRSS {
+        int pid;
+        int64_t maxRSS;
+    };
+    __thread ChildRSS rssHistory[rssHistorySize];
+    __thread int rssHistoryNext = 0;
+}
+
+// Searches from the most recent entry, so that a reused pid finds the
+// latest child with that pid.
+int64_t getProcessMaxRSS(int pid) {
+    for (int n = 1; n <= rssHistorySize; ++n) {
+        ChildRSS &entry =
+            rssHistory[(rssHistoryNext - n + rssHistorySize) % rssHistorySize];
+        if (entry.pid == pid)
+            return entry.maxRSS;
+    }
+    return 0;
+}
+
 // returns the exit status if exited, or the signal that killed or stopped
 // the process in the most sig byte with a bit flag set in 9 or 10 depending
 // on how it was signaled, or bit 8 set for "still running"
@@ -34,9 +62,16 @@ int waitProcess(int pid, int noHang) {
 
 // UNIX
     int status, retPid;
-    retPid = waitpid(pid, &status, (noHang)?WNOHANG:0);
+    struct rusage usage;
+    retPid = wait4(pid, &status, (noHang)?WNOHANG:0, &usage);
     if (noHang && retPid == 0)
         return CRK_PROC_STILL_RUNNING;
+    if (retPid > 0) {
+        ChildRSS &entry = rssHistory[rssHistoryNext];
+        entry.pid = retPid;
+        entry.maxRSS = usage.ru_maxrss;
+        rssHistoryNext = (rssHistoryNext + 1) % rssHistorySize;
+    }
     if (WIFEXITED(status)) {
         return CRK_PROC_EXITED | WEXITSTATUS(status);
     }
@@ -75,76 +110,89 @@ void closeProcess(PipeDesc *pd) {
 
 }
 
-int runChildProcess(const char **argv,
-                    const char **env,
-                    PipeDesc *pd
-                    ) {
-
-    assert(pd && "no PipeDesc passed");
-
-// UNIX
-    // set to unreadable initially
-    pd->in = -1;
-    pd->out = -1;
-    pd->err = -1;
-
-    int pipes[3][2]; // 0,1,2 (in,out,err) x 0,1 (read,write)
-
-    // create pipes
-    // XXX check pd to see which pipes we should make, if any
-    for (int i = 0; i < 3; i++) {
-        if (pd->flags & (1 << i) && pipe(pipes[i]) == -1) {
-            perror("pipe failed");
+namespace {
+
+    // Creates a pipe with close-on-exec set on both ends.  All of the pipe
+    // ends are created close-on-exec, the ones that a child needs are dup'ed
+    // onto its standard descriptors (which clears the flag), so no child
+    // inherits the pipes of any other child.
+    int makePipe(int fds[2]) {
+#ifdef __linux__
+        return pipe2(fds, O_CLOEXEC);
+#else
+        if (pipe(fds) == -1)
             return -1;
-        }
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        return 0;
+#endif
     }
 
-    pid_t p = fork();
-
-    switch (p) {
-    case -1:
-        perror("fork failed");
+    // returns the end of pipe 'i' (0, 1, 2 for in, out, err) that belongs to
+    // the child.
+    inline int childEnd(int pipes[3][2], int i) {
+        return i ? pipes[i][1] : pipes[i][0];
+    }
 
-        // clean the pipes
+    // Start the child with posix_spawn() (which uses vfork() or
+    // clone(CLONE_VFORK), so it doesn't have to copy the parent's page
+    // tables).  Returns -1 if the child couldn't be spawned.
+    pid_t spawnChild(const char **argv, const char **env, int flags,
+                     int pipes[3][2]
+                     ) {
+        posix_spawn_file_actions_t actions;
+        if (posix_spawn_file_actions_init(&actions))
+            return -1;
         for (int i = 0; i < 3; ++i)
-            for (int j = 1; i < 2; ++j)
-                if (pipes[i][j] != -1)
-                    close(pipes[i][j]);
+            if (flags & (1 << i))
+                posix_spawn_file_actions_adddup2(&actions, childEnd(pipes, i),
+                                                 i
+                                                 );
+
+        posix_spawnattr_t attrs;
+        posix_spawnattr_init(&attrs);
+#ifdef POSIX_SPAWN_USEVFORK
+        posix_spawnattr_setflags(&attrs, POSIX_SPAWN_USEVFORK);
+#endif
+
+        pid_t pid;
+        int rc;
+        if (env)
+            rc = posix_spawn(&pid, argv[0], &actions, &attrs,
+                             const_cast<char* const*>(argv),
+                             const_cast<char* const*>(env)
+                             );
+        else
+            rc = posix_spawnp(&pid, argv[0], &actions, &attrs,
+                              const_cast<char* const*>(argv),
+                              environ
+                              );
+
+        posix_spawnattr_destroy(&attrs);
+        posix_spawn_file_actions_destroy(&actions);
+        return rc ? -1 : pid;
+    }
+
+    // Start the child with fork() and exec.  Unlike spawnChild(), failure to
+    // exec the program is reported through the child's exit status
+    // (CRK_PROC_EXECFAIL).
+    pid_t forkChild(const char **argv, const char **env, int flags,
+                    int pipes[3][2]
+                    ) {
+        pid_t p = fork();
+        if (p)
+            return p;
 
-        return -1;
-    case 0:
         // child
-        if (pd->flags & 1) {
-            if (close(pipes[0][1]) == -1) { // child stdin write close
-                perror("close - child 0");
-                return -1;
-            }
-            if (pipes[0][0] != STDIN_FILENO) {
-                dup2(pipes[0][0], STDIN_FILENO);
-                close(pipes[0][0]);
+        for (int i = 0; i < 3; ++i) {
+            if (flags & (1 << i)) {
+                int fd = childEnd(pipes, i);
+                if (fd == i)
+                    fcntl(fd, F_SETFD, 0);
+                else
+                    dup2(fd, i);
             }
         }
-        if (pd->flags & 2) {
-            if (close(pipes[1][0]) == -1) { // child stdout read close
-                perror("close - child 1");
-                return -1;
-            }
-            if (pipes[1][1] != STDOUT_FILENO) {
-                dup2(pipes[1][1], STDOUT_FILENO);
-                close(pipes[1][1]);
-            }
-        }
-        if (pd->flags & 4) {
-            if (close(pipes[2][0]) == -1) { // child stderr read close
-                perror("close - child 2");
-                return -1;
-            }
-            if (pipes[2][1] != STDERR_FILENO) {
-                dup2(pipes[2][1], STDERR_FILENO);
-                close(pipes[2][1]);
-            }
-        }
-        // XXX close all handles > 2?
 
         if (env) {
             execve(argv[0],
@@ -157,41 +205,66 @@ int runChildProcess(const char **argv,
 
         // if we get here, exec failed
         _exit(-1);
+    }
+}
+
+int runChildProcess(const char **argv,
+                    const char **env,
+                    PipeDesc *pd
+                    ) {
 
-    default:
-        // parent
+    assert(pd && "no PipeDesc passed");
 
-        // parent stdin read close
-        if (pd->flags & 1) {
-            if (close(pipes[0][0]) == -1) {
-                perror("close - parent 0");
-                return -1;
-            }
-            // return pipes[0][1] as writeable fd (to child stdin)
-            pd->in = pipes[0][1];
-        }
-        // parent stdout write close
-        if (pd->flags & 2) {
-                if (close(pipes[1][1]) == -1) {
-                perror("close - parent 1");
-                return -1;
-            }
-            // return pipes[1][0] as readable fd (from child stdout)
-            pd->out = pipes[1][0];
-        }
-        // parent stderr write close
-        if (pd->flags & 4) {
-            if (close(pipes[2][1]) == -1) {
-                perror("close - parent 2");
-                return -1;
-            }
-            // return pipes[2][0] as readable fd (from child stderr)
-            pd->err = pipes[2][0];
+// UNIX
+    // set to unreadable initially
+    pd->in = -1;
+    pd->out = -1;
+    pd->err = -1;
+
+    int pipes[3][2]; // 0,1,2 (in,out,err) x 0,1 (read,write)
+
+    // create pipes
+    for (int i = 0; i < 3; i++) {
+        pipes[i][0] = pipes[i][1] = -1;
+        if (pd->flags & (1 << i) && makePipe(pipes[i]) == -1) {
+            perror("pipe failed");
+            for (int j = 0; j < i; ++j)
+                for (int k = 0; k < 2; ++k)
+                    if (pipes[j][k] != -1)
+                        close(pipes[j][k]);
+            return -1;
         }
+    }
 
-        return p;
+    // posix_spawn() reports a failure to exec the program as an error, fall
+    // back to fork() in that case so that the failure gets reported the same
+    // way it always has been: as the exit code of the child.
+    pid_t p = spawnChild(argv, env, pd->flags, pipes);
+    if (p == -1)
+        p = forkChild(argv, env, pd->flags, pipes);
+
+    if (p == -1)
+        perror("fork failed");
+
+    // close the child's ends of the pipes and return the parent's ends: the
+    // write end of stdin and the read ends of stdout and stderr.
+    for (int i = 0; i < 3; ++i) {
+        if (!(pd->flags & (1 << i)))
+            continue;
+        close(childEnd(pipes, i));
+        int parentEnd = i ? pipes[i][0] : pipes[i][1];
+        if (p == -1)
+            close(parentEnd);
+        else if (i == 0)
+            pd->in = parentEnd;
+        else if (i == 1)
+            pd->out = parentEnd;
+        else
+            pd->err = parentEnd;
     }
 
+    return p;
+
 // END UNIX
 
 }
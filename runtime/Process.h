@@ -5,6 +5,7 @@
 //   file, You can obtain one at http://mozilla.org/MPL/2.0/.
 // 
 
+#include <stdint.h>
 
 namespace crack { namespace runtime {
 
@@ -32,6 +33,11 @@ void closeProcess(PipeDesc *pd);
 
 int waitProcess(int pid, int noHang);
 
+// Returns the peak resident set size (in kilobytes) of the child process
+// 'pid', which must be one of the last few processes reaped by
+// waitProcess() on this thread.  Returns 0 if the process isn't known.
+int64_t getProcessMaxRSS(int pid);
+
 void signalProcess(int pid, int sig);
 
 } }
@@ -25,6 +25,9 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <iconv.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace crack { namespace runtime {
 
@@ -44,12 +47,6 @@ unsigned int rand(unsigned int low, unsigned int high) {
     return r;
 }
 
-// this is temporary until we implement float printing in crack
-// assumes caller allocates and owns buffer
-int float_str(double d, char* buf, unsigned int size) {
-    return snprintf(buf, size, "%f", d);
-}
-
 int crk_puts(char *str) {
     return puts(str);
 }
@@ -86,6 +83,216 @@ int is_file(const char *path) {
     return S_ISREG(sb.st_mode);
 }
 
+int findByte(const char *buf, char c, unsigned int size) {
+    const char *p = (const char *)memchr(buf, c, size);
+    return p ? p - buf : -1;
+}
+
+// The JSON scanners check 16 bytes at a time with SSE2 where it's available.
+int findJsonStringDelim(const char *buf, unsigned int size) {
+    unsigned int i = 0;
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi8('"'),
+                  backslash = _mm_set1_epi8('\\'),
+                  maxControl = _mm_set1_epi8(0x1f);
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(buf + i));
+        
+        // unsigned chunk <= 0x1f is max(chunk, 0x1f) == 0x1f
+        __m128i hits = 
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                             _mm_cmpeq_epi8(chunk, backslash)
+                             ),
+                _mm_cmpeq_epi8(_mm_max_epu8(chunk, maxControl), maxControl)
+            );
+        int mask = _mm_movemask_epi8(hits);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < size; ++i) {
+        unsigned char c = buf[i];
+        if (c == '"' || c == '\\' || c < 0x20)
+            return i;
+    }
+    return -1;
+}
+
+unsigned int skipJsonWhitespace(const char *buf, unsigned int size) {
+    unsigned int i = 0;
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'),
+                  newline = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(buf + i));
+        __m128i ws =
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                             _mm_cmpeq_epi8(chunk, tab)
+                             ),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, newline),
+                             _mm_cmpeq_epi8(chunk, cr)
+                             )
+            );
+        int mask = ~_mm_movemask_epi8(ws) & 0xffff;
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < size; ++i) {
+        char c = buf[i];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            return i;
+    }
+    return size;
+}
+
+int rfindByte(const char *buf, char c, unsigned int size) {
+#ifdef __GLIBC__
+    const char *p = (const char *)memrchr(buf, c, size);
+    return p ? p - buf : -1;
+#else
+    while (size--)
+        if (buf[size] == c)
+            return size;
+    return -1;
+#endif
+}
+
+int findBytes(const char *buf, unsigned int size, const char *sub,
+              unsigned int subSize
+              ) {
+#ifdef __GLIBC__
+    const char *p = (const char *)memmem(buf, size, sub, subSize);
+    return p ? p - buf : -1;
+#else
+    if (!subSize)
+        return 0;
+    unsigned int start = 0;
+    while (start + subSize <= size) {
+        int i = findByte(buf + start, sub[0], size - start - subSize + 1);
+        if (i < 0)
+            return -1;
+        if (!memcmp(buf + start + i, sub, subSize))
+            return start + i;
+        start += i + 1;
+    }
+    return -1;
+#endif
+}
+
+int rfindBytes(const char *buf, unsigned int size, const char *sub,
+               unsigned int subSize
+               ) {
+    if (subSize > size)
+        return -1;
+    if (!subSize)
+        return size;
+
+    // 'end' is the end of the range of possible starting positions.
+    unsigned int end = size - subSize + 1;
+    while (end) {
+        int i = rfindByte(buf, sub[0], end);
+        if (i < 0)
+            return -1;
+        if (!memcmp(buf + i, sub, subSize))
+            return i;
+        end = i;
+    }
+    return -1;
+}
+
+namespace {
+
+    // Sets with up to this many bytes are checked 16 bytes at a time with
+    // SSE2 (one compare per byte in the set), larger ones use a table.
+    const unsigned int maxVectorSetSize = 8;
+
+    // Returns the index of the first byte in 'buf' that is in the set (or
+    // not in the set, if 'inSet' is false), -1 if there is none.
+    int scanByteSet(const char *buf, unsigned int size, const char *set,
+                    unsigned int setSize,
+                    bool inSet
+                    ) {
+        unsigned int i = 0;
+#ifdef __SSE2__
+        if (setSize <= maxVectorSetSize) {
+            __m128i needles[maxVectorSetSize];
+            for (unsigned int j = 0; j < setSize; ++j)
+                needles[j] = _mm_set1_epi8(set[j]);
+
+            for (; i + 16 <= size; i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i *)(buf + i));
+                __m128i hits = _mm_setzero_si128();
+                for (unsigned int j = 0; j < setSize; ++j)
+                    hits = _mm_or_si128(hits,
+                                        _mm_cmpeq_epi8(chunk, needles[j])
+                                        );
+                int mask = _mm_movemask_epi8(hits);
+                if (!inSet)
+                    mask = ~mask & 0xffff;
+                if (mask)
+                    return i + __builtin_ctz(mask);
+            }
+        }
+#endif
+        bool table[256];
+        memset(table, 0, sizeof(table));
+        for (unsigned int j = 0; j < setSize; ++j)
+            table[static_cast<unsigned char>(set[j])] = true;
+
+        for (; i < size; ++i)
+            if (table[static_cast<unsigned char>(buf[i])] == inSet)
+                return i;
+        return -1;
+    }
+}
+
+int findByteInSet(const char *buf, unsigned int size, const char *set,
+                  unsigned int setSize
+                  ) {
+    return scanByteSet(buf, size, set, setSize, true);
+}
+
+int findByteNotInSet(const char *buf, unsigned int size, const char *set,
+                     unsigned int setSize
+                     ) {
+    return scanByteSet(buf, size, set, setSize, false);
+}
+
+// the element loops are written with memcpy() so that they work on unaligned
+// buffers and can be vectorized.
+void xdrCopy32(void *dst, const void *src, unsigned int count) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    memmove(dst, src, count * 4);
+#else
+    char *d = static_cast<char *>(dst);
+    const char *s = static_cast<const char *>(src);
+    for (unsigned int i = 0; i < count; ++i) {
+        uint32_t val;
+        memcpy(&val, s + i * 4, 4);
+        val = __builtin_bswap32(val);
+        memcpy(d + i * 4, &val, 4);
+    }
+#endif
+}
+
+void xdrCopy64(void *dst, const void *src, unsigned int count) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    memmove(dst, src, count * 8);
+#else
+    char *d = static_cast<char *>(dst);
+    const char *s = static_cast<const char *>(src);
+    for (unsigned int i = 0; i < count; ++i) {
+        uint64_t val;
+        memcpy(&val, s + i * 8, 8);
+        val = __builtin_bswap64(val);
+        memcpy(d + i * 8, &val, 8);
+    }
+#endif
+}
+
 bool fileExists(const char *path) {
     struct stat st;
     return stat(path, &st) == 0;
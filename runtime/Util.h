@@ -18,7 +18,6 @@ namespace crack { namespace runtime {
 
 char* strerror(void);
 
-int float_str(double, char* buf, unsigned int size);
 unsigned int rand(unsigned int low, unsigned int high);
 int crk_puts(char *str);
 int crk_putc(char byte);
@@ -28,6 +27,49 @@ void printint(int val);
 void printint64(int64_t val);
 void printuint64(uint64_t val);
 
+// Returns the index of the first occurrence of 'c' in the first 'size' 
+// bytes of 'buf', -1 if there is none.
+int findByte(const char *buf, char c, unsigned int size);
+
+// Returns the index of the last occurrence of 'c' in the first 'size' bytes
+// of 'buf', -1 if there is none.
+int rfindByte(const char *buf, char c, unsigned int size);
+
+// Returns the index of the first (or last) occurrence of the 'subSize' bytes
+// at 'sub' in the first 'size' bytes of 'buf', -1 if there is none.  An
+// empty 'sub' is found at 0 (or 'size').
+int findBytes(const char *buf, unsigned int size, const char *sub,
+              unsigned int subSize
+              );
+int rfindBytes(const char *buf, unsigned int size, const char *sub,
+               unsigned int subSize
+               );
+
+// Returns the index of the first byte in 'buf' that is (or is not) one of
+// the 'setSize' bytes in 'set', -1 if there is none.
+int findByteInSet(const char *buf, unsigned int size, const char *set,
+                  unsigned int setSize
+                  );
+int findByteNotInSet(const char *buf, unsigned int size, const char *set,
+                     unsigned int setSize
+                     );
+
+// Returns the index of the first byte in 'buf' that ends a run of plain
+// JSON string characters (a double quote, a backslash or a control
+// character), -1 if there is none.
+int findJsonStringDelim(const char *buf, unsigned int size);
+
+// Returns the index of the first byte in 'buf' that isn't JSON whitespace
+// (space, tab, newline or carriage return), 'size' if there is none.
+unsigned int skipJsonWhitespace(const char *buf, unsigned int size);
+
+// Copy 'count' 32 bit (or 64 bit) values from 'src' to 'dst', converting
+// between host and big endian (XDR) byte order.  The conversion is its own
+// inverse, so these serve for both encoding and decoding.  Neither buffer
+// needs to be aligned.
+void xdrCopy32(void *dst, const void *src, unsigned int count);
+void xdrCopy64(void *dst, const void *src, unsigned int count);
+
 int is_file(const char *path);
 bool fileExists(const char *path);
 int setNonBlocking(int fd, int val);
@@ -23,8 +23,9 @@
         delete xdrs;
     }
 
-    bool xdr_error;
-    unsigned int xdr_size;
+    // per-thread so that streams on different threads have their own status.
+    __thread bool xdr_error;
+    __thread unsigned int xdr_size;
 
     bool crk_xdr_error(){
         return xdr_error;
@@ -6,11 +6,13 @@
 //   file, You can obtain one at http://mozilla.org/MPL/2.0/.
 // 
 
+#include <pthread.h>
 #include <string.h>
 #include "ext/Func.h"
 #include "ext/Module.h"
 #include "ext/Type.h"
 #include "ext/util.h"
+#include "runtime/Alloc.h"
 
 #include <iostream>
 
@@ -48,6 +50,42 @@ int callback(int (*cb)(int)) {
     return cb(100);
 }
 
+void *allocObjectInThread(void *arg) { return __CrackAllocObject(48); }
+
+void *freeObjectInThread(void *obj) {
+    __CrackFreeObject(obj);
+    return 0;
+}
+
+// Checks that object memory can be freed in a different thread from the one 
+// that allocated it.  Returns 1 on success.
+int freeObjectsAcrossThreads() {
+    pthread_t thread;
+    void *obj;
+
+    // allocate in a thread that exits, then free and reuse the block here.
+    if (pthread_create(&thread, 0, allocObjectInThread, 0) ||
+        pthread_join(thread, &obj) ||
+        !obj
+        )
+        return 0;
+    memset(obj, 0xff, 48);
+    __CrackFreeObject(obj);
+    char *reused = static_cast<char *>(__CrackAllocObject(48));
+    if (reused != obj)
+        return 0;
+    for (int i = 0; i < 48; ++i)
+        if (reused[i])
+            return 0;
+
+    // free it in a thread that exits, which releases its free lists.
+    if (pthread_create(&thread, 0, freeObjectInThread, reused) ||
+        pthread_join(thread, 0)
+        )
+        return 0;
+    return 1;
+}
+
 extern "C" void testext_rinit(void) {
     cout << "in testext" << endl;
 }
@@ -159,6 +197,10 @@ extern "C" void testext_cinit(Module *mod) {
     f = mod->addFunc(mod->getIntType(), "callback", (void *)callback);
     f->addArg(intFuncType, "cb");
 
+    mod->addFunc(mod->getIntType(), "freeObjectsAcrossThreads",
+                 (void *)freeObjectsAcrossThreads
+                 );
+
     // create a type with virtual methods.  We create a hidden type to 
     // strictly correspond to the instance area of the underlying type, then 
     // derive our proxy type from VTableBase and our hidden type.